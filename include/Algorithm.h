@@ -3,12 +3,394 @@
 #ifndef _CHUSTL_ALGORITHM_H_
 #define _CHUSTL_ALGORITHM_H_
 
+#include <cstring>		// for memmove, memset, memchr, memcmp
+#include <type_traits>
+
 #include "Iterator.h"
 
 namespace ChuSTL {
 
-    
+	/*
+	* 㷨: min, max, copy, copy_backward, fill, fill_n, find, search, equal, lexicographical_compare
+	* Ϊʱto_addressȡԭָ룬Ԫͽmemmove/memset/memchr/memcmpδ
+	* ˰װָĵԭָͬ죻ȡԼѭ
+	* ڲChuSTL::޶Щ㷨ԪstdʱADLstdеͬ㷨
+	*/
+
+	// ʱa
+	template<class T>
+	inline const T& min(const T& a, const T& b) {
+		return b < a ? b : a;
+	}
+	template<class T, class Compare>
+	inline const T& min(const T& a, const T& b, Compare comp) {
+		return comp(b, a) ? b : a;
+	}
+
+	// ʱa
+	template<class T>
+	inline const T& max(const T& a, const T& b) {
+		return a < b ? b : a;
+	}
+	template<class T, class Compare>
+	inline const T& max(const T& a, const T& b, Compare comp) {
+		return comp(a, b) ? b : a;
+	}
+
+	// ֽڵͣmemset/memchr
+	template<class T>
+	struct __is_byte : std::integral_constant<bool,
+		std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value> {};
+
+	// ˶ԪͬҿƽֵʱƵͬmemmove
+	template<class InputIterator, class OutputIterator>
+	struct __memmove_copyable {
+		typedef typename iterator_traits<InputIterator>::value_type T;
+		typedef std::integral_constant<bool,
+			__is_contiguous_iterator<InputIterator>::value && __is_contiguous_iterator<OutputIterator>::value
+			&& std::is_same<T, typename iterator_traits<OutputIterator>::value_type>::value
+			&& std::is_trivially_copy_assignable<T>::value> type;
+	};
+
+	// ԪΪֽʱmemset/memchr
+	template<class Iterator>
+	struct __byte_range {
+		typedef std::integral_constant<bool,
+			__is_contiguous_iterator<Iterator>::value
+			&& __is_byte<typename iterator_traits<Iterator>::value_type>::value> type;
+	};
+
+	// ֵָȵҽʾȣ˶ʱmemcmpж
+	template<class InputIterator1, class InputIterator2>
+	struct __memcmp_equal {
+		typedef typename iterator_traits<InputIterator1>::value_type T;
+		typedef std::integral_constant<bool,
+			__is_contiguous_iterator<InputIterator1>::value && __is_contiguous_iterator<InputIterator2>::value
+			&& std::is_same<T, typename iterator_traits<InputIterator2>::value_type>::value
+			&& (std::is_integral<T>::value || std::is_pointer<T>::value)> type;
+	};
+
+	// memcmpunsigned charȽϣunsigned charеֵһ
+	template<class InputIterator1, class InputIterator2>
+	struct __memcmp_less {
+		typedef std::integral_constant<bool,
+			__is_contiguous_iterator<InputIterator1>::value && __is_contiguous_iterator<InputIterator2>::value
+			&& std::is_same<typename iterator_traits<InputIterator1>::value_type, unsigned char>::value
+			&& std::is_same<typename iterator_traits<InputIterator2>::value_type, unsigned char>::value> type;
+	};
+
+
+	/*
+	* copy : [first, last)Ƶ[result, result + (last - first))result + (last - first)
+	* λ֮ǰǰص
+	*/
+	template<class InputIterator, class OutputIterator>
+	inline OutputIterator
+		__copy(InputIterator first, InputIterator last, OutputIterator result, input_iterator_tag) {
+		for (; first != last; ++first, ++result)
+			*result = *first;
+		return result;
+	}
+
+	template<class RandomAccessIterator, class OutputIterator>
+	inline OutputIterator
+		__copy(RandomAccessIterator first, RandomAccessIterator last, OutputIterator result, random_access_iterator_tag) {
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+		for (Distance n = last - first; n > 0; --n, ++first, ++result)
+			*result = *first;
+		return result;
+	}
+
+	template<class InputIterator, class OutputIterator>
+	inline OutputIterator
+		__copy_dispatch(InputIterator first, InputIterator last, OutputIterator result, std::false_type) {
+		return __copy(first, last, result, iterator_category(first));
+	}
+
+	template<class InputIterator, class OutputIterator>
+	inline OutputIterator
+		__copy_dispatch(InputIterator first, InputIterator last, OutputIterator result, std::true_type) {
+		typedef typename iterator_traits<InputIterator>::value_type T;
+		ptrdiff_t n = last - first;
+		if (n > 0)
+			memmove(ChuSTL::to_address(result), ChuSTL::to_address(first), n * sizeof(T));
+		return result + n;
+	}
+
+	template<class InputIterator, class OutputIterator>
+	inline OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result) {
+		return __copy_dispatch(first, last, result, typename __memmove_copyable<InputIterator, OutputIterator>::type());
+	}
+
+	/*
+	* copy_backward : [first, last)ɺǰƵresultΪյ䣬
+	* յλ֮ڣص
+	*/
+	template<class BidirectionalIterator1, class BidirectionalIterator2>
+	inline BidirectionalIterator2
+		__copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result,
+			bidirectional_iterator_tag) {
+		while (first != last)
+			*--result = *--last;
+		return result;
+	}
+
+	template<class RandomAccessIterator, class BidirectionalIterator>
+	inline BidirectionalIterator
+		__copy_backward(RandomAccessIterator first, RandomAccessIterator last, BidirectionalIterator result,
+			random_access_iterator_tag) {
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+		for (Distance n = last - first; n > 0; --n)
+			*--result = *--last;
+		return result;
+	}
+
+	template<class BidirectionalIterator1, class BidirectionalIterator2>
+	inline BidirectionalIterator2
+		__copy_backward_dispatch(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result,
+			std::false_type) {
+		return __copy_backward(first, last, result, iterator_category(first));
+	}
+
+	template<class BidirectionalIterator1, class BidirectionalIterator2>
+	inline BidirectionalIterator2
+		__copy_backward_dispatch(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result,
+			std::true_type) {
+		typedef typename iterator_traits<BidirectionalIterator1>::value_type T;
+		ptrdiff_t n = last - first;
+		if (n > 0) {
+			result = result - n;
+			memmove(ChuSTL::to_address(result), ChuSTL::to_address(first), n * sizeof(T));
+		}
+		return result;
+	}
+
+	template<class BidirectionalIterator1, class BidirectionalIterator2>
+	inline BidirectionalIterator2
+		copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
+		return __copy_backward_dispatch(first, last, result,
+			typename __memmove_copyable<BidirectionalIterator1, BidirectionalIterator2>::type());
+	}
+
+	/*
+	* fill : [first, last)ڵÿԪظֵΪx
+	* ֽԪؽmemsetȻԭָ룬ڱ
+	*/
+	template<class ForwardIterator, class T>
+	inline void __fill(ForwardIterator first, ForwardIterator last, const T& x, forward_iterator_tag) {
+		for (; first != last; ++first)
+			*first = x;
+	}
+
+	template<class RandomAccessIterator, class T>
+	inline void __fill(RandomAccessIterator first, RandomAccessIterator last, const T& x, random_access_iterator_tag) {
+		typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+		for (Distance n = last - first; n > 0; --n, ++first)
+			*first = x;
+	}
+
+	template<class ContiguousIterator, class T>
+	inline void __fill(ContiguousIterator first, ContiguousIterator last, const T& x, contiguous_iterator_tag) {
+		ptrdiff_t n = last - first;
+		if (n > 0) {
+			typedef typename iterator_traits<ContiguousIterator>::value_type value_type;
+			value_type* p = ChuSTL::to_address(first);
+			__fill(p, p + n, x, random_access_iterator_tag());
+		}
+	}
+
+	template<class ForwardIterator, class T>
+	inline void __fill_dispatch(ForwardIterator first, ForwardIterator last, const T& x, std::false_type) {
+		__fill(first, last, x, iterator_category(first));
+	}
+
+	template<class ForwardIterator, class T>
+	inline void __fill_dispatch(ForwardIterator first, ForwardIterator last, const T& x, std::true_type) {
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		ptrdiff_t n = last - first;
+		if (n > 0)
+			memset(ChuSTL::to_address(first), static_cast<unsigned char>(value_type(x)), n);
+	}
+
+	template<class ForwardIterator, class T>
+	inline void fill(ForwardIterator first, ForwardIterator last, const T& x) {
+		__fill_dispatch(first, last, x, typename __byte_range<ForwardIterator>::type());
+	}
+
+	// fill_n : [first, first + n)ڵÿԪظֵΪxfirst + n
+	template<class OutputIterator, class Size, class T>
+	inline OutputIterator __fill_n_dispatch(OutputIterator first, Size n, const T& x, std::false_type) {
+		for (; n > 0; --n, ++first)
+			*first = x;
+		return first;
+	}
+
+	template<class OutputIterator, class Size, class T>
+	inline OutputIterator __fill_n_dispatch(OutputIterator first, Size n, const T& x, std::true_type) {
+		typedef typename iterator_traits<OutputIterator>::value_type value_type;
+		if (n <= 0)
+			return first;
+		memset(ChuSTL::to_address(first), static_cast<unsigned char>(value_type(x)), size_t(n));
+		return first + n;
+	}
+
+	template<class OutputIterator, class Size, class T>
+	inline OutputIterator fill_n(OutputIterator first, Size n, const T& x) {
+		return __fill_n_dispatch(first, n, x, typename __byte_range<OutputIterator>::type());
+	}
+
+	/*
+	* find : [first, last)еһvalueλãûʱlast
+	* ֽԪvaluememchr
+	*/
+	template<class InputIterator, class T>
+	inline InputIterator __find(InputIterator first, InputIterator last, const T& value, std::false_type) {
+		while (first != last && !(*first == value))
+			++first;
+		return first;
+	}
+
+	template<class ContiguousIterator, class T>
+	inline ContiguousIterator __find(ContiguousIterator first, ContiguousIterator last, const T& value, std::true_type) {
+		typedef typename iterator_traits<ContiguousIterator>::value_type value_type;
+		ptrdiff_t n = last - first;
+		value_type v = static_cast<value_type>(value);
+		// valueԪ͵ķΧʱ
+		if (n <= 0 || !(v == value))
+			return last;
+		const unsigned char* s = reinterpret_cast<const unsigned char*>(ChuSTL::to_address(first));
+		const void* p = memchr(s, static_cast<unsigned char>(v), n);
+		return p ? first + (static_cast<const unsigned char*>(p) - s) : last;
+	}
+
+	template<class InputIterator, class T>
+	inline InputIterator find(InputIterator first, InputIterator last, const T& value) {
+		typedef std::integral_constant<bool,
+			__byte_range<InputIterator>::type::value && std::is_integral<T>::value> use_memchr;
+		return __find(first, last, value, use_memchr());
+	}
+
+	/*
+	* search : [first1, last1)вҵһ[first2, last2)ȵУ㣬ûʱlast1
+	* ˶ͬĵֽԪʱmemchrԪصĺѡλãmemcmpȽಿ
+	*/
+	template<class ForwardIterator1, class ForwardIterator2>
+	ForwardIterator1 __search(ForwardIterator1 first1, ForwardIterator1 last1,
+		ForwardIterator2 first2, ForwardIterator2 last2, std::false_type) {
+		if (first2 == last2)
+			return first1;
+		for (; ; ++first1) {
+			ForwardIterator1 it1 = first1;
+			ForwardIterator2 it2 = first2;
+			for (;;) {
+				if (it2 == last2)
+					return first1;
+				if (it1 == last1)
+					return last1;
+				if (!(*it1 == *it2))
+					break;
+				++it1;
+				++it2;
+			}
+		}
+	}
+
+	template<class ContiguousIterator1, class ContiguousIterator2>
+	ContiguousIterator1 __search(ContiguousIterator1 first1, ContiguousIterator1 last1,
+		ContiguousIterator2 first2, ContiguousIterator2 last2, std::true_type) {
+		ptrdiff_t n1 = last1 - first1;
+		ptrdiff_t n2 = last2 - first2;
+		if (n2 <= 0)
+			return first1;
+		if (n1 < n2)
+			return last1;
+		const unsigned char* s = reinterpret_cast<const unsigned char*>(ChuSTL::to_address(first1));
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(ChuSTL::to_address(first2));
+		const unsigned char* end = s + (n1 - n2 + 1);	// ܵΪ[s, end)
+		for (const unsigned char* cur = s; cur != end; ++cur) {
+			cur = static_cast<const unsigned char*>(memchr(cur, *p, end - cur));
+			if (!cur)
+				break;
+			if (memcmp(cur + 1, p + 1, n2 - 1) == 0)
+				return first1 + (cur - s);
+		}
+		return last1;
+	}
+
+	template<class ForwardIterator1, class ForwardIterator2>
+	inline ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
+		ForwardIterator2 first2, ForwardIterator2 last2) {
+		typedef std::integral_constant<bool,
+			__byte_range<ForwardIterator1>::type::value && __byte_range<ForwardIterator2>::type::value
+			&& std::is_same<typename iterator_traits<ForwardIterator1>::value_type,
+				typename iterator_traits<ForwardIterator2>::value_type>::value> use_memchr;
+		return __search(first1, last1, first2, last2, use_memchr());
+	}
+
+	/*
+	* equal : ж[first1, last1)first2ʼĵȳǷ
+	* ˶ԪΪָͬʱmemcmp
+	*/
+	template<class InputIterator1, class InputIterator2>
+	inline bool __equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type) {
+		for (; first1 != last1; ++first1, ++first2)
+			if (!(*first1 == *first2))
+				return false;
+		return true;
+	}
+
+	template<class InputIterator1, class InputIterator2>
+	inline bool __equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::true_type) {
+		typedef typename iterator_traits<InputIterator1>::value_type T;
+		ptrdiff_t n = last1 - first1;
+		return n <= 0 || memcmp(ChuSTL::to_address(first1), ChuSTL::to_address(first2), n * sizeof(T)) == 0;
+	}
+
+	template<class InputIterator1, class InputIterator2>
+	inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+		return __equal(first1, last1, first2, typename __memcmp_equal<InputIterator1, InputIterator2>::type());
+	}
+
+	template<class InputIterator1, class InputIterator2, class BinaryPredicate>
+	inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred) {
+		for (; first1 != last1; ++first1, ++first2)
+			if (!pred(*first1, *first2))
+				return false;
+		return true;
+	}
+
+	/*
+	* lexicographical_compare : ж[first1, last1)ǷֵС[first2, last2)
+	* ˶unsigned charʱmemcmp
+	*/
+	template<class InputIterator1, class InputIterator2>
+	inline bool __lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, InputIterator2 last2, std::false_type) {
+		for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+			if (*first1 < *first2)
+				return true;
+			if (*first2 < *first1)
+				return false;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+
+	template<class InputIterator1, class InputIterator2>
+	inline bool __lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, InputIterator2 last2, std::true_type) {
+		ptrdiff_t n1 = last1 - first1;
+		ptrdiff_t n2 = last2 - first2;
+		ptrdiff_t n = n1 < n2 ? n1 : n2;
+		int r = n > 0 ? memcmp(ChuSTL::to_address(first1), ChuSTL::to_address(first2), n) : 0;
+		return r != 0 ? r < 0 : n1 < n2;
+	}
 
+	template<class InputIterator1, class InputIterator2>
+	inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+		InputIterator2 first2, InputIterator2 last2) {
+		return __lexicographical_compare(first1, last1, first2, last2,
+			typename __memcmp_less<InputIterator1, InputIterator2>::type());
+	}
 
 }
 
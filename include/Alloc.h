@@ -3,10 +3,35 @@
 #ifndef _CHUSTL_ALLOC_H_
 #define _CHUSTL_ALLOC_H_
 
+#include <cstddef>
+#include <type_traits>
+
 namespace ChuSTL {
 
+	// AllocǷṩͷŵdeallocate_chain(first, last, n, bytes)
+	template<class Alloc>
+	class __has_deallocate_chain {
+		template<class A>
+		static std::true_type test(decltype(&A::deallocate_chain));
+		template<class A>
+		static std::false_type test(...);
+	public:
+		typedef decltype(test<Alloc>(0)) type;
+	};
+
 	template<class T, class Alloc>
 	class simple_alloc {
+		static void deallocate_chain(void* first, void* last, size_t n, std::true_type) {
+			Alloc::deallocate_chain(first, last, n, sizeof(T));
+		}
+		static void deallocate_chain(void* first, void*, size_t n, std::false_type) {
+			while (n--) {
+				void* next = *static_cast<void**>(first);
+				Alloc::deallocate(first, sizeof(T));
+				first = next;
+			}
+		}
+
 	public:
 		static T* allocate(size_t n) {
 			return 0 == n ? 0 : (T*)Alloc::allocate(n * sizeof(T));
@@ -21,6 +46,13 @@ namespace ChuSTL {
 		static void deallocate(T* p) {
 			Alloc::deallocate(p, sizeof(T));
 		}
+		// һͷn󣬸Կͷһvoid*(free listĸʽ)firstlastΪβ
+		// Allocṩdeallocate_chainʱfree listֻӵͷͷ
+		static void deallocate_chain(void* first, void* last, size_t n) {
+			static_assert(sizeof(T) >= sizeof(void*), "deallocate_chain needs room for a link in each object");
+			if (0 != n)
+				deallocate_chain(first, last, n, typename __has_deallocate_chain<Alloc>::type());
+		}
 	};
 
 	template<int inst>
@@ -9,6 +9,7 @@
 #include <climits>		// for UINT_MAX
 #include <iostream>		// for cerr
 
+#include "Iterator.h"		// for value_type
 #include "TypeTraits.h"
 
 namespace ChuSTL {
@@ -40,23 +41,20 @@ namespace ChuSTL {
 		ptr->~T();
 	}
 
-	// ڶ汾
-	// value_typeȡͣ__type_traits<>жǷǷҪtrivial destructor
-	template<class ForwardIterator>
-	inline void destroy(ForwardIterator first, ForwardIterator last) {
-		__destroy(first, last, value_type(first));
+	// pָδʼռvalueT1
+	template<class T1, class T2>
+	inline void construct(T1* p, const T2& value) {
+		_construct(p, value);
 	}
 
-	// жԪֵǷtrivial destructorָ...
-	// ûϵͳԴģ˵ûʲôãĬϻᱻã
-	template<class ForwardIterator, class T>
-	inline void __destroy(ForwardIterator first, ForwardIterator last, T*) {
-		typedef typename __type_traits<T>::has_trivial_destructor trivial_destructor;
-		__destroy_aux(first, last, trivial_destructor());
+	// pָĶ󣬵ͷſռ
+	template<class T>
+	inline void destroy(T* pointer) {
+		_destroy(pointer);
 	}
 
 	// Ԫصֵûtrivial destructor
-	template<class ForwardIterator, class T>
+	template<class ForwardIterator>
 	inline void
 		__destroy_aux(ForwardIterator first, ForwardIterator last, std::false_type) { // __false_type
 		for (; first < last; ++first) {
@@ -69,6 +67,21 @@ namespace ChuSTL {
 	inline void
 		__destroy_aux(ForwardIterator first, ForwardIterator last, std::true_type) { } // __true_type
 
+	// жԪֵǷtrivial destructorָ...
+	// ûϵͳԴģ˵ûʲôãĬϻᱻã
+	template<class ForwardIterator, class T>
+	inline void __destroy(ForwardIterator first, ForwardIterator last, T*) {
+		typedef typename __type_traits<T>::has_trivial_destructor trivial_destructor;
+		__destroy_aux(first, last, trivial_destructor());
+	}
+
+	// ڶ汾
+	// value_typeȡͣ__type_traits<>жǷǷҪtrivial destructor
+	template<class ForwardIterator>
+	inline void destroy(ForwardIterator first, ForwardIterator last) {
+		__destroy(first, last, value_type(first));
+	}
+
 	// char*wchar_t*ػ
 	inline void destroy(char*, char*) {}
 	inline void destroy(wchar_t*, wchar_t*) {}
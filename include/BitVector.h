@@ -0,0 +1,472 @@
+#pragma once
+
+#ifndef _CHUSTL_BITVECTOR_H_
+#define _CHUSTL_BITVECTOR_H_
+
+#include <cstring>		// for memcpy, memset
+
+#include "Alloc.h"
+#include "Iterator.h"
+#include "Vector.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ChuSTL {
+
+	// vector<bool>64λΪλ
+	typedef unsigned long long __bit_word;
+	enum { __word_bit = 64 };
+
+	// 1ĸӲָʱpopcnt
+	inline size_t __bit_popcount(__bit_word x) {
+#if defined(__GNUC__) || defined(__clang__)
+		return size_t(__builtin_popcountll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return size_t(__popcnt64(x));
+#else
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return size_t((x * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	// λ1λãxΪ0Ӳָʱtzcnt/bsf
+	inline size_t __bit_ctz(__bit_word x) {
+#if defined(__GNUC__) || defined(__clang__)
+		return size_t(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, x);
+		return size_t(index);
+#else
+		size_t n = 0;
+		while (!(x & 1)) {
+			x >>= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	// ָ򵥸bitĴ
+	struct __bit_reference {
+		__bit_word* p;
+		__bit_word mask;
+
+		__bit_reference() : p(0), mask(0) {}
+		__bit_reference(__bit_word* x, __bit_word m) : p(x), mask(m) {}
+
+		operator bool() const { return (*p & mask) != 0; }
+		__bit_reference& operator=(bool x) {
+			if (x)
+				*p |= mask;
+			else
+				*p &= ~mask;
+			return *this;
+		}
+		__bit_reference& operator=(const __bit_reference& x) { return *this = bool(x); }
+		bool operator==(const __bit_reference& x) const { return bool(*this) == bool(x); }
+		bool operator<(const __bit_reference& x) const { return !bool(*this) && bool(x); }
+		void flip() { *p ^= mask; }
+	};
+
+	// λĹּ֣ƫ
+	struct __bit_iterator_base {
+		typedef random_access_iterator_tag	iterator_category;
+		typedef bool						value_type;
+		typedef ptrdiff_t					difference_type;
+
+		__bit_word* p;
+		unsigned int offset;
+
+		__bit_iterator_base(__bit_word* x, unsigned int y) : p(x), offset(y) {}
+
+		void bump_up() {
+			if (offset++ == __word_bit - 1) {
+				offset = 0;
+				++p;
+			}
+		}
+		void bump_down() {
+			if (offset-- == 0) {
+				offset = __word_bit - 1;
+				--p;
+			}
+		}
+		// ֳΪ2ݣλ
+		void incr(difference_type i) {
+			difference_type n = i + offset;
+			p += n >> 6;
+			offset = unsigned(n & (__word_bit - 1));
+		}
+
+		bool operator==(const __bit_iterator_base& x) const { return p == x.p && offset == x.offset; }
+		bool operator!=(const __bit_iterator_base& x) const { return p != x.p || offset != x.offset; }
+		bool operator<(const __bit_iterator_base& x) const {
+			return p < x.p || (p == x.p && offset < x.offset);
+		}
+		bool operator>(const __bit_iterator_base& x) const { return x < *this; }
+		bool operator<=(const __bit_iterator_base& x) const { return !(x < *this); }
+		bool operator>=(const __bit_iterator_base& x) const { return !(*this < x); }
+	};
+
+	inline ptrdiff_t operator-(const __bit_iterator_base& x, const __bit_iterator_base& y) {
+		return __word_bit * (x.p - y.p) + x.offset - y.offset;
+	}
+
+	struct __bit_iterator : public __bit_iterator_base {
+		typedef __bit_reference		reference;
+		typedef __bit_reference*	pointer;
+		typedef __bit_iterator		iterator;
+		typedef __bit_iterator		self;
+
+		__bit_iterator() : __bit_iterator_base(0, 0) {}
+		__bit_iterator(__bit_word* x, unsigned int y) : __bit_iterator_base(x, y) {}
+
+		reference operator*() const { return reference(p, __bit_word(1) << offset); }
+		self& operator++() {
+			bump_up();
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			bump_up();
+			return tmp;
+		}
+		self& operator--() {
+			bump_down();
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			bump_down();
+			return tmp;
+		}
+		self& operator+=(difference_type i) {
+			incr(i);
+			return *this;
+		}
+		self& operator-=(difference_type i) {
+			*this += -i;
+			return *this;
+		}
+		self operator+(difference_type i) const {
+			self tmp = *this;
+			return tmp += i;
+		}
+		self operator-(difference_type i) const {
+			self tmp = *this;
+			return tmp -= i;
+		}
+		reference operator[](difference_type i) const { return *(*this + i); }
+	};
+
+	struct __bit_const_iterator : public __bit_iterator_base {
+		typedef bool					reference;
+		typedef bool					const_reference;
+		typedef const bool*				pointer;
+		typedef __bit_const_iterator	const_iterator;
+		typedef __bit_const_iterator	self;
+
+		__bit_const_iterator() : __bit_iterator_base(0, 0) {}
+		__bit_const_iterator(__bit_word* x, unsigned int y) : __bit_iterator_base(x, y) {}
+		__bit_const_iterator(const __bit_iterator& x) : __bit_iterator_base(x.p, x.offset) {}
+
+		const_reference operator*() const { return (*p & (__bit_word(1) << offset)) != 0; }
+		self& operator++() {
+			bump_up();
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			bump_up();
+			return tmp;
+		}
+		self& operator--() {
+			bump_down();
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			bump_down();
+			return tmp;
+		}
+		self& operator+=(difference_type i) {
+			incr(i);
+			return *this;
+		}
+		self& operator-=(difference_type i) {
+			*this += -i;
+			return *this;
+		}
+		self operator+(difference_type i) const {
+			self tmp = *this;
+			return tmp += i;
+		}
+		self operator-(difference_type i) const {
+			self tmp = *this;
+			return tmp -= i;
+		}
+		const_reference operator[](difference_type i) const { return *(*this + i); }
+	};
+
+	/*
+	* vector<bool>ػ棺ÿԪֻռ1 bit64λΪλ
+	* һгsize()λʼձΪ0count()λ˿ִ
+	* vectorһAllocΪdata_allocatorsizeof(bool)Ϊ1boolüֽ
+	*/
+	template<class Alloc, class GrowthPolicy>
+	class vector<bool, Alloc, GrowthPolicy> {
+	public:
+		typedef bool					value_type;
+		typedef size_t					size_type;
+		typedef ptrdiff_t				difference_type;
+		typedef __bit_reference			reference;
+		typedef bool					const_reference;
+		typedef __bit_reference*		pointer;
+		typedef const bool*				const_pointer;
+		typedef __bit_iterator			iterator;
+		typedef __bit_const_iterator	const_iterator;
+
+	protected:
+		typedef Alloc data_allocator;
+
+		__bit_word* start;			// һ
+		size_type num_bits;			// Ԫظ
+		__bit_word* end_of_storage;	// ÿռβ
+
+		static size_type words_for(size_type n) { return (n + __word_bit - 1) >> 6; }
+
+		size_type word_count() const { return words_for(num_bits); }
+		size_type word_capacity() const { return size_type(end_of_storage - start); }
+
+		static __bit_word* allocate_words(size_type n) {
+			return (__bit_word*)data_allocator::allocate(n * sizeof(__bit_word));
+		}
+		static void deallocate_words(__bit_word* p, size_type n) {
+			if (p)
+				data_allocator::deallocate((bool*)p, n * sizeof(__bit_word));
+		}
+
+		// һгsize()λ
+		void sanitize_tail() {
+			size_type extra = num_bits & (__word_bit - 1);
+			if (extra)
+				start[num_bits >> 6] &= (__bit_word(1) << extra) - 1;
+		}
+
+		// nֵĿռ䣬nСword_count()
+		void reallocate(size_type n) {
+			__bit_word* new_start = allocate_words(n);
+			if (word_count())
+				memcpy(new_start, start, word_count() * sizeof(__bit_word));
+			deallocate_words(start, word_capacity());
+			start = new_start;
+			end_of_storage = new_start + n;
+		}
+
+		// nԪʱԾµ
+		void grow_to(size_type n) {
+			size_type words = words_for(n);
+			if (words > word_capacity())
+				reallocate(GrowthPolicy::next_capacity(word_count(), words, sizeof(__bit_word)));
+		}
+
+		void initialize(size_type n, bool value) {
+			size_type words = words_for(n);
+			start = allocate_words(words);
+			end_of_storage = start + words;
+			num_bits = n;
+			if (words) {
+				memset(start, value ? 0xff : 0, words * sizeof(__bit_word));
+				sanitize_tail();
+			}
+		}
+
+		iterator make_iterator(size_type n) const {
+			return iterator(start + (n >> 6), unsigned(n & (__word_bit - 1)));
+		}
+
+	public:
+		vector() : start(0), num_bits(0), end_of_storage(0) {}
+		vector(size_type n, bool value) { initialize(n, value); }
+		vector(int n, bool value) { initialize(n, value); }
+		vector(long n, bool value) { initialize(n, value); }
+		explicit vector(size_type n) { initialize(n, false); }
+		vector(const vector& x) {
+			size_type words = x.word_count();
+			start = allocate_words(words);
+			end_of_storage = start + words;
+			num_bits = x.num_bits;
+			if (words)
+				memcpy(start, x.start, words * sizeof(__bit_word));
+		}
+		vector& operator=(const vector& x) {
+			if (this != &x) {
+				if (x.word_count() > word_capacity()) {
+					deallocate_words(start, word_capacity());
+					start = allocate_words(x.word_count());
+					end_of_storage = start + x.word_count();
+				}
+				num_bits = x.num_bits;
+				if (x.word_count())
+					memcpy(start, x.start, x.word_count() * sizeof(__bit_word));
+			}
+			return *this;
+		}
+		~vector() {
+			deallocate_words(start, word_capacity());
+		}
+
+		iterator begin() { return iterator(start, 0); }
+		const_iterator begin() const { return const_iterator(start, 0); }
+		const_iterator cbegin() const { return const_iterator(start, 0); }
+		iterator end() { return make_iterator(num_bits); }
+		const_iterator end() const { return make_iterator(num_bits); }
+		const_iterator cend() const { return make_iterator(num_bits); }
+
+		size_type size() const { return num_bits; }
+		size_type capacity() const { return word_capacity() * __word_bit; }
+		bool empty() const { return num_bits == 0; }
+		reference operator[](size_type n) {
+			return reference(start + (n >> 6), __bit_word(1) << (n & (__word_bit - 1)));
+		}
+		const_reference operator[](size_type n) const {
+			return (start[n >> 6] >> (n & (__word_bit - 1))) & 1;
+		}
+		reference front() { return (*this)[0]; }
+		reference back() { return (*this)[num_bits - 1]; }
+
+		// ײִ֣һֳsize()λΪ0
+		__bit_word* words() { return start; }
+		const __bit_word* words() const { return start; }
+		size_type num_words() const { return word_count(); }
+
+		void push_back(bool x) {
+			if (num_bits == capacity())
+				grow_to(num_bits + 1);
+			if ((num_bits & (__word_bit - 1)) == 0)
+				start[num_bits >> 6] = 0;
+			(*this)[num_bits++] = x;
+		}
+		void pop_back() {
+			(*this)[--num_bits] = false;
+		}
+		void resize(size_type new_size, bool x) {
+			if (new_size > num_bits) {
+				grow_to(new_size);
+				size_type old_size = num_bits;
+				size_type old_words = word_count();
+				num_bits = new_size;
+				// ֱ䣬ٲԭһеλ
+				memset(start + old_words, x ? 0xff : 0, (word_count() - old_words) * sizeof(__bit_word));
+				if (x)
+					for (size_type i = old_size; i < (old_words << 6) && i < new_size; ++i)
+						(*this)[i] = true;
+				sanitize_tail();
+			}
+			else {
+				num_bits = new_size;
+				sanitize_tail();
+			}
+		}
+		void resize(size_type new_size) {
+			resize(new_size, false);
+		}
+		void clear() { num_bits = 0; }
+		void reserve(size_type n) {
+			if (words_for(n) > word_capacity())
+				reallocate(words_for(n));
+		}
+		void shrink_to_fit() {
+			if (word_count() < word_capacity())
+				reallocate(word_count());
+		}
+		void assign(size_type n, bool x) {
+			clear();
+			resize(n, x);
+		}
+
+		iterator insert(iterator position, bool x) {
+			difference_type n = position - begin();
+			push_back(false);
+			position = begin() + n;
+			for (iterator i = end() - 1; i != position; --i)
+				*i = *(i - 1);
+			*position = x;
+			return position;
+		}
+		iterator erase(iterator position) {
+			return erase(position, position + 1);
+		}
+		iterator erase(iterator first, iterator last) {
+			iterator i = first;
+			for (iterator j = last; j != end(); ++i, ++j)
+				*i = *j;
+			num_bits -= last - first;
+			sanitize_tail();
+			return first;
+		}
+
+		// λȡ
+		void flip() {
+			for (size_type i = 0; i < word_count(); ++i)
+				start[i] = ~start[i];
+			sanitize_tail();
+		}
+
+		// ֵΪtrueԪظpopcount
+		size_type count() const {
+			size_type n = 0;
+			for (size_type i = 0; i < word_count(); ++i)
+				n += __bit_popcount(start[i]);
+			return n;
+		}
+		// һֵΪtrueԪλãûʱsize()
+		size_type find_first() const {
+			return find_from(0);
+		}
+		// pos֮һֵΪtrueԪλãûʱsize()
+		size_type find_next(size_type pos) const {
+			return pos + 1 >= num_bits ? num_bits : find_from(pos + 1);
+		}
+
+		// ֵλ㣬ߵsize()ͬ
+		vector& operator&=(const vector& x) {
+			for (size_type i = 0; i < word_count(); ++i)
+				start[i] &= x.start[i];
+			return *this;
+		}
+		vector& operator|=(const vector& x) {
+			for (size_type i = 0; i < word_count(); ++i)
+				start[i] |= x.start[i];
+			return *this;
+		}
+		vector& operator^=(const vector& x) {
+			for (size_type i = 0; i < word_count(); ++i)
+				start[i] ^= x.start[i];
+			return *this;
+		}
+
+	protected:
+		size_type find_from(size_type pos) const {
+			size_type i = pos >> 6;
+			if (i >= word_count())
+				return num_bits;
+			// һεpos֮ǰλȫ0
+			__bit_word w = start[i] & (~__bit_word(0) << (pos & (__word_bit - 1)));
+			while (w == 0) {
+				if (++i == word_count())
+					return num_bits;
+				w = start[i];
+			}
+			return (i << 6) + __bit_ctz(w);
+		}
+	};
+
+}
+
+#endif // !_CHUSTL_BITVECTOR_H_
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#ifndef _CHUSTL_BLOCKINGQUEUE_H_
+#define _CHUSTL_BLOCKINGQUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "Deque.h"
+
+namespace ChuSTL {
+
+	/*
+	* blocking_queue: һײнУ֮ıѹ
+	* ʱpushȴȡΪʱpopȴ߷룻_forİ汾ȴʱ
+	* pop_nһμȡԪأ߿Գ̯뻽ѵĿ
+	* close()֮pushһʧܣpopԿȡʣԪأȡ󷵻falseٵȴ
+	* capacityΪ0ʾʱpushӲȴ
+	*/
+	template<class T, class Alloc, class Container = deque<T, Alloc>>
+	class blocking_queue {
+	public:
+		typedef typename Container::value_type		value_type;
+		typedef typename Container::size_type		size_type;
+		typedef typename Container::reference		reference;
+		typedef typename Container::const_reference	const_reference;
+
+	protected:
+		Container c;
+		size_type cap;
+		bool closed;
+		mutable std::mutex mutex;
+		std::condition_variable not_empty;
+		std::condition_variable not_full;
+
+		bool full() const { return cap != 0 && c.size() >= cap; }
+		// ڳmutexʱ
+		void push_locked(const value_type& x) {
+			c.push_back(x);
+			not_empty.notify_one();
+		}
+		void pop_locked(value_type& result) {
+			result = c.front();
+			c.pop_front();
+			not_full.notify_one();
+		}
+
+	private:
+		blocking_queue(const blocking_queue&);
+		blocking_queue& operator=(const blocking_queue&);
+
+	public:
+		explicit blocking_queue(size_type capacity = 0) : c(), cap(capacity), closed(false) {}
+
+		size_type capacity() const { return cap; }
+		size_type size() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return c.size();
+		}
+		bool empty() const { return size() == 0; }
+		bool is_closed() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return closed;
+		}
+
+		// ʱȴѹرʱfalse
+		bool push(const value_type& x) {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (full() && !closed)
+				not_full.wait(lock);
+			if (closed)
+				return false;
+			push_locked(x);
+			return true;
+		}
+		// ѹرʱfalse
+		bool try_push(const value_type& x) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (closed || full())
+				return false;
+			push_locked(x);
+			return true;
+		}
+		// ȴtimeoutʱѹرʱfalse
+		template<class Rep, class Period>
+		bool push_for(const value_type& x, const std::chrono::duration<Rep, Period>& timeout);
+
+		// Ϊʱȴѹرȡʱfalse
+		bool pop(value_type& result) {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (c.size() == 0 && !closed)
+				not_empty.wait(lock);
+			if (c.size() == 0)
+				return false;
+			pop_locked(result);
+			return true;
+		}
+		// Ϊʱfalse
+		bool try_pop(value_type& result) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (c.size() == 0)
+				return false;
+			pop_locked(result);
+			return true;
+		}
+		// ȴtimeoutʱѹرȡʱfalse
+		template<class Rep, class Period>
+		bool pop_for(value_type& result, const std::chrono::duration<Rep, Period>& timeout);
+		// ȵһԪأͬһμȡnдresultȡĸ
+		// nΪ0ʱ0ֻڶѹرȡʱŷ0
+		template<class OutputIterator>
+		size_type pop_n(OutputIterator result, size_type n);
+
+		// رնвеȴ
+		void close() {
+			std::lock_guard<std::mutex> lock(mutex);
+			closed = true;
+			not_empty.notify_all();
+			not_full.notify_all();
+		}
+	};
+
+	// 𾭹timeoutʱ̡timeout󵽳steady_clockķΧʱȡtime_point::max()
+	// now() + timeoutɹȥʱ̶ʱ
+	template<class Rep, class Period>
+	std::chrono::steady_clock::time_point __deadline_after(const std::chrono::duration<Rep, Period>& timeout) {
+		typedef std::chrono::steady_clock clock;
+		typedef std::chrono::duration<long double, clock::period> wide_duration;
+		clock::time_point now = clock::now();
+		if (timeout <= timeout.zero())
+			return now;
+		if (wide_duration(timeout) >= wide_duration(clock::time_point::max() - now))
+			return clock::time_point::max();
+		return now + std::chrono::duration_cast<clock::duration>(timeout);
+	}
+
+	template<class T, class Alloc, class Container>
+	template<class Rep, class Period>
+	bool blocking_queue<T, Alloc, Container>::push_for(const value_type& x, const std::chrono::duration<Rep, Period>& timeout)
+	{
+		std::chrono::steady_clock::time_point deadline = __deadline_after(timeout);
+		std::unique_lock<std::mutex> lock(mutex);
+		while (full() && !closed)
+			if (not_full.wait_until(lock, deadline) == std::cv_status::timeout && full())
+				return false;
+		if (closed)
+			return false;
+		push_locked(x);
+		return true;
+	}
+
+	template<class T, class Alloc, class Container>
+	template<class Rep, class Period>
+	bool blocking_queue<T, Alloc, Container>::pop_for(value_type& result, const std::chrono::duration<Rep, Period>& timeout)
+	{
+		std::chrono::steady_clock::time_point deadline = __deadline_after(timeout);
+		std::unique_lock<std::mutex> lock(mutex);
+		while (c.size() == 0 && !closed)
+			if (not_empty.wait_until(lock, deadline) == std::cv_status::timeout && c.size() == 0)
+				return false;
+		if (c.size() == 0)
+			return false;
+		pop_locked(result);
+		return true;
+	}
+
+	template<class T, class Alloc, class Container>
+	template<class OutputIterator>
+	typename blocking_queue<T, Alloc, Container>::size_type
+	blocking_queue<T, Alloc, Container>::pop_n(OutputIterator result, size_type n)
+	{
+		if (n == 0)
+			return 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		while (c.size() == 0 && !closed)
+			not_empty.wait(lock);
+		size_type k = 0;
+		for (; k != n && c.size() != 0; ++k, ++result) {
+			*result = c.front();
+			c.pop_front();
+		}
+		// һڳλжڵȴ
+		if (k > 1)
+			not_full.notify_all();
+		else if (k == 1)
+			not_full.notify_one();
+		return k;
+	}
+
+}
+
+#endif // !_CHUSTL_BLOCKINGQUEUE_H_
\ No newline at end of file
@@ -0,0 +1,674 @@
+#pragma once
+
+#ifndef _CHUSTL_CONCURRENTSKIPLIST_H_
+#define _CHUSTL_CONCURRENTSKIPLIST_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>	// for less
+#include <new>
+#include <utility>		// for pair
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Iterator.h"
+#include "Epoch.h"
+
+namespace ChuSTL {
+
+	template<class Pair>
+	struct __select1st {
+		const typename Pair::first_type& operator()(const Pair& x) const { return x.first; }
+	};
+
+	template<class T>
+	struct __identity {
+		const T& operator()(const T& x) const { return x; }
+	};
+
+	// ڵ㣬nextʵʳΪlevelڵһ
+	template<class Value>
+	struct __skiplist_node : epoch_retired {
+		typedef std::atomic<uintptr_t> link;	// λΪ1ʾڵڸòѱɾָ벻ٸı
+
+		std::atomic<unsigned long long> insert_version;	// Чİ汾0ʾδ
+		std::atomic<unsigned long long> erase_version;	// ɾЧİ汾0ʾȻ
+		std::atomic<int> owners;		// ժ߸һݣֵһ𽻸
+		int level;
+		__skiplist_node* deferred_next;	// ӳժջ
+		Value value;
+		link next[1];
+	};
+
+	template<class Node>
+	inline size_t __skiplist_node_bytes(int level) {
+		return sizeof(Node) + (level - 1) * sizeof(typename Node::link);
+	}
+
+	template<class Node, class Alloc>
+	inline void __skiplist_deallocate_node(Node* p) {
+		simple_alloc<char, Alloc>::deallocate(reinterpret_cast<char*>(p), __skiplist_node_bytes<Node>(p->level));
+	}
+
+	template<class List>
+	struct __skiplist_iterator {
+		typedef forward_iterator_tag							iterator_category;
+		typedef typename List::value_type						value_type;
+		typedef const value_type*								pointer;
+		typedef const value_type&								reference;
+		typedef size_t											size_type;
+		typedef ptrdiff_t										difference_type;
+		typedef __skiplist_iterator								self;
+		typedef typename List::link_type						link_type;
+
+		const List* list;
+		link_type node;
+		unsigned long long version;
+
+		__skiplist_iterator() : list(0), node(0), version(0) {}
+		__skiplist_iterator(const List* l, link_type x, unsigned long long v) : list(l), node(x), version(v) {}
+
+		reference operator*() const { return node->value; }
+		pointer operator->() const { return &(operator*()); }
+		self& operator++() {
+			node = list->next_visible(node, version);
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+		bool operator==(const self& x) const { return node == x.node; }
+		bool operator!=(const self& x) const { return node != x.node; }
+	};
+
+	/*
+	* __concurrent_skiplist: concurrent_mapconcurrent_setõ
+	* Ҳ0CASɣϸֻ֮㲹
+	* ɾΪڵɾ汾(߼ɾ)ٴӸ߲㵽0Ǹָ벢ժ
+	* ;ѱǵĽڵʱ˳ֽժժµĽڵ㽻epoch
+	*
+	* գÿβ롢ɾЧʱclockȡһ°汾ţռ´ʱİ汾S
+	* ԿտɼĽڵǲ汾Sδɾɾ汾S
+	* 򿪵Ŀڲ۱еǼ汾ɾ汾յĽڵֻ¡ݲժӳջ
+	* ֮Ĳ롢ɾչرʱټӳջѶпղɼĽڵ漴ժ
+	* ˿ڼɼĽڵʼУSʱ̵ȫһ
+	*
+	* ڵ㾭simple_alloc<char, Alloc>ãAllocɱ߳ͬʱ
+	* ճepochٽڴ߳ʹú
+	*/
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	class __concurrent_skiplist {
+	public:
+		typedef Key																key_type;
+		typedef Value															value_type;
+		typedef const Value&													const_reference;
+		typedef size_t															size_type;
+		typedef ptrdiff_t														difference_type;
+		typedef Compare															key_compare;
+		typedef __skiplist_iterator<__concurrent_skiplist>						const_iterator;
+		typedef const_iterator													iterator;
+		class snapshot;
+
+		friend struct __skiplist_iterator<__concurrent_skiplist>;
+		friend class snapshot;
+
+	protected:
+		typedef __skiplist_node<Value>											node_type;
+		typedef node_type*														link_type;
+		typedef typename node_type::link										link;
+		typedef simple_alloc<char, Alloc>										node_allocator;
+		typedef epoch_reclaimer<Alloc>											epoch;
+		typedef typename epoch::guard											guard;
+
+		enum {
+			max_level = 32,
+			snapshot_slots = 64,		// ʱ˻ΪֹһժֱĿչر
+			drain_interval = 64			// ÿ߳ÿɴ޸ļһӳջ
+		};
+		static const unsigned long long slot_opening = ~0ull;
+
+		link_type head;
+		Compare comp;
+		mutable std::atomic<unsigned long long> clock;	// һηİ汾
+		std::atomic<size_type> count;
+		std::atomic<size_type> open_snapshots;
+		std::atomic<size_type> overflow_snapshots;
+		std::atomic<unsigned long long> snapshot_version[snapshot_slots];	// 0ʾУΪ汾 + 1
+		std::atomic<link_type> deferred;	// ɾʱԶĳտɼдժĽڵ
+
+		static link_type ptr_of(uintptr_t x) { return reinterpret_cast<link_type>(x & ~uintptr_t(1)); }
+		static bool is_marked(uintptr_t x) { return (x & 1) != 0; }
+		static link_type next_of(link_type p, int l) { return ptr_of(p->next[l].load(std::memory_order_acquire)); }
+		static bool is_unlinked(link_type p) { return is_marked(p->next[0].load(std::memory_order_acquire)); }
+
+		const key_type& key(link_type p) const { return KeyOfValue()(p->value); }
+
+		// 1/2ĸ
+		static int random_level() {
+			static thread_local unsigned long long seed = 0;
+			if (seed == 0)
+				seed = (reinterpret_cast<uintptr_t>(&seed) | 1) * 0x9E3779B97F4A7C15ull;
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+			int level = 1;
+			for (unsigned long long r = seed; (r & 1) && level < max_level; r >>= 1)
+				++level;
+			return level;
+		}
+
+		static link_type allocate_node(int level) {
+			link_type p = reinterpret_cast<link_type>(node_allocator::allocate(__skiplist_node_bytes<node_type>(level)));
+			new (&p->insert_version) std::atomic<unsigned long long>(0);
+			new (&p->erase_version) std::atomic<unsigned long long>(0);
+			new (&p->owners) std::atomic<int>(2);
+			p->level = level;
+			p->deferred_next = 0;
+			p->retire_next = 0;
+			p->reclaim = &reclaim_node;
+			for (int l = 0; l < level; ++l)
+				new (&p->next[l]) link(0);
+			return p;
+		}
+		static link_type create_node(int level, const value_type& x) {
+			link_type p = allocate_node(level);
+			try {
+				construct(&p->value, x);
+			}
+			catch (...) {
+				__skiplist_deallocate_node<node_type, Alloc>(p);
+				throw;
+			}
+			return p;
+		}
+		// δĽڵͷ
+		static void destroy_node(link_type p) {
+			destroy(&p->value);
+			__skiplist_deallocate_node<node_type, Alloc>(p);
+		}
+		// epochĽڵ㵽ȫʱɴͷ
+		static void reclaim_node(epoch_retired* p) {
+			destroy_node(static_cast<link_type>(p));
+		}
+
+		// Ϊڵϲ汾δµĽڵʱκ̶߳ɴΪ
+		unsigned long long stamp_insert(link_type p) const {
+			unsigned long long v = p->insert_version.load(std::memory_order_acquire);
+			if (v)
+				return v;
+			unsigned long long fresh = clock.fetch_add(1) + 1;
+			if (p->insert_version.compare_exchange_strong(v, fresh))
+				return fresh;
+			return v;
+		}
+		bool is_alive(link_type p) const {
+			stamp_insert(p);
+			return p->erase_version.load(std::memory_order_acquire) == 0;
+		}
+		bool is_visible(link_type p, unsigned long long version) const {
+			if (stamp_insert(p) > version)
+				return false;
+			unsigned long long e = p->erase_version.load(std::memory_order_acquire);
+			return e == 0 || e > version;
+		}
+
+		// λkڸǰ̣;ժѱǵĽڵ
+		// ͣڵһkkԴڵĽڵ㣬غǷ
+		bool find(const key_type& k, link_type* preds, link_type* succs);
+		// ȷ㶼ѱǵpӸժ
+		// Ƴժڼͬһٴβ룬½ڵp֮ҿܱpߣÿ㶼ֻСƽ
+		// μȵĽڵ㣬ַҳp
+		void unlink_levels(link_type p);
+
+		// ֻҳһСkĽڵ㣬޸κ
+		link_type seek(const key_type& k) const;
+		link_type first_visible(link_type p, unsigned long long version) const {
+			while (p && !is_visible(p, version))
+				p = next_of(p, 0);
+			return p;
+		}
+		link_type next_visible(link_type p, unsigned long long version) const {
+			return first_visible(next_of(p, 0), version);
+		}
+		// һkҴ˿̴ڵĽڵ
+		link_type find_alive(const key_type& k) const {
+			for (link_type p = seek(k); p && !comp(k, key(p)); p = next_of(p, 0))
+				if (is_alive(p))
+					return p;
+			return 0;
+		}
+
+		// ߻ժ߷֣ȷڵѴӸժ󽻸epoch
+		void release(link_type p) {
+			if (p->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				unlink_levels(p);
+				epoch::retire(p);
+			}
+		}
+		// Ӹ߲㵽0pĸָ룬ٽժ
+		void unlink_node(link_type p) {
+			for (int l = p->level - 1; l >= 0; --l) {
+				uintptr_t s = p->next[l].load(std::memory_order_acquire);
+				while (!is_marked(s) && !p->next[l].compare_exchange_weak(s, s | 1, std::memory_order_acq_rel))
+					;
+			}
+			release(p);
+		}
+		// д򿪵Ŀİ汾ûпʱΪֵ
+		// ڴ򿪵Ŀδȡð汾Ϊ0
+		unsigned long long oldest_snapshot() const;
+		// ɾ汾пյĽڵκοնѲɼ֮򿪵ĿҲ
+		bool is_reclaimable(link_type p) const {
+			return open_snapshots.load() == 0 || p->erase_version.load() <= oldest_snapshot();
+		}
+		void push_deferred(link_type first, link_type last) {
+			link_type top = deferred.load(std::memory_order_relaxed);
+			do {
+				last->deferred_next = top;
+			} while (!deferred.compare_exchange_weak(top, first, std::memory_order_release, std::memory_order_relaxed));
+		}
+		// Ѹɾ汾Ľڵ㣺ٱҪʱժƳ
+		void unlink_or_defer(link_type p) {
+			if (is_reclaimable(p))
+				unlink_node(p);
+			else
+				push_deferred(p, p);
+		}
+		void drain_deferred();
+		void maybe_drain_deferred() {
+			static thread_local unsigned ticks = 0;
+			if (deferred.load(std::memory_order_relaxed) && ++ticks % drain_interval == 0)
+				drain_deferred();
+		}
+
+		// Ǽһ汾ΪvĿգvΪ0ʱȡǰ汾õĲۣʱsnapshot_slots
+		int open_snapshot(unsigned long long& v);
+		void close_snapshot(int slot);
+
+		void free_all();
+
+	private:
+		__concurrent_skiplist(const __concurrent_skiplist&);
+		__concurrent_skiplist& operator=(const __concurrent_skiplist&);
+
+	public:
+		explicit __concurrent_skiplist(const Compare& c = Compare())
+			: head(allocate_node(max_level)), comp(c), clock(0), count(0), open_snapshots(0), overflow_snapshots(0), deferred(0) {
+			for (int i = 0; i < snapshot_slots; ++i)
+				new (&snapshot_version[i]) std::atomic<unsigned long long>(0);
+		}
+		// ʱ̷߳ʣҲδرյĿ
+		~__concurrent_skiplist() { free_all(); }
+
+		// ޸ڼֻǽֵ
+		size_type size() const { return count.load(std::memory_order_relaxed); }
+		bool empty() const { return size() == 0; }
+		key_compare key_comp() const { return comp; }
+
+		// Ѵʱ룬false
+		bool insert(const value_type& x);
+		bool erase(const key_type& k);
+		bool contains(const key_type& k) const {
+			guard g;
+			return find_alive(k) != 0;
+		}
+
+		snapshot get_snapshot() const { return snapshot(const_cast<__concurrent_skiplist*>(this)); }
+
+		// ĳһ汾µֻͼɰɨ
+		class snapshot {
+		public:
+			typedef __concurrent_skiplist::const_iterator const_iterator;
+			typedef const_iterator iterator;
+
+		protected:
+			__concurrent_skiplist* list;
+			unsigned long long version;
+			int slot;
+
+		public:
+			explicit snapshot(__concurrent_skiplist* l) : list(l), version(0) {
+				epoch::enter();
+				slot = list->open_snapshot(version);
+			}
+			// ԭȻ򿪣ͬ汾ǼǲκҪĽڵ
+			snapshot(const snapshot& x) : list(x.list), version(x.version) {
+				epoch::enter();
+				slot = list->open_snapshot(version);
+			}
+			~snapshot() {
+				list->close_snapshot(slot);
+				list->drain_deferred();
+				epoch::leave();
+			}
+
+			unsigned long long get_version() const { return version; }
+			const_iterator begin() const {
+				return const_iterator(list, list->first_visible(next_of(list->head, 0), version), version);
+			}
+			const_iterator end() const { return const_iterator(list, 0, version); }
+			// һСkԪ
+			const_iterator lower_bound(const key_type& k) const {
+				return const_iterator(list, list->first_visible(list->seek(k), version), version);
+			}
+			// һkԪ
+			const_iterator upper_bound(const key_type& k) const {
+				link_type p = list->first_visible(list->seek(k), version);
+				while (p && !list->comp(k, list->key(p)))
+					p = list->next_visible(p, version);
+				return const_iterator(list, p, version);
+			}
+			const_iterator find(const key_type& k) const {
+				const_iterator i = lower_bound(k);
+				return (i.node && !list->comp(k, list->key(i.node))) ? i : end();
+			}
+
+		private:
+			snapshot& operator=(const snapshot&);
+		};
+	};
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	bool __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::find(const key_type& k,
+		link_type* preds, link_type* succs)
+	{
+	retry:
+		link_type pred = head;
+		for (int l = max_level - 1; l >= 0; --l) {
+			link_type curr = next_of(pred, l);
+			while (curr) {
+				uintptr_t succ = curr->next[l].load(std::memory_order_acquire);
+				// currڸòѱǣժpredʱCASʧܣͷ
+				while (is_marked(succ)) {
+					uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+					if (!pred->next[l].compare_exchange_strong(expected, succ & ~uintptr_t(1), std::memory_order_acq_rel))
+						goto retry;
+					curr = ptr_of(succ);
+					if (!curr)
+						break;
+					succ = curr->next[l].load(std::memory_order_acquire);
+				}
+				if (!curr)
+					break;
+				if (comp(key(curr), k) || (!comp(k, key(curr)) && !is_alive(curr))) {
+					pred = curr;
+					curr = ptr_of(succ);
+				}
+				else {
+					break;
+				}
+			}
+			preds[l] = pred;
+			succs[l] = curr;
+		}
+		return succs[0] && !comp(k, key(succs[0]));
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	void __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::unlink_levels(link_type p)
+	{
+		const key_type& k = key(p);
+	retry:
+		link_type pred = head;
+		for (int l = max_level - 1; l >= 0; --l) {
+			// ƽòһСkĽڵ㣬;ժѱǵĽڵ
+			link_type curr = next_of(pred, l);
+			while (curr) {
+				uintptr_t succ = curr->next[l].load(std::memory_order_acquire);
+				if (is_marked(succ)) {
+					uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+					if (!pred->next[l].compare_exchange_strong(expected, succ & ~uintptr_t(1), std::memory_order_acq_rel))
+						goto retry;
+					curr = ptr_of(succ);
+				}
+				else if (comp(key(curr), k)) {
+					pred = curr;
+					curr = ptr_of(succ);
+				}
+				else {
+					break;
+				}
+			}
+			if (l >= p->level)
+				continue;
+			// kһΣժѱǵĽڵ㣬p㶼ѱǣڸòžһᱻժ
+			link_type prev = pred;
+			while (curr && !comp(k, key(curr))) {
+				uintptr_t succ = curr->next[l].load(std::memory_order_acquire);
+				if (is_marked(succ)) {
+					uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+					if (!prev->next[l].compare_exchange_strong(expected, succ & ~uintptr_t(1), std::memory_order_acq_rel))
+						goto retry;
+				}
+				else {
+					prev = curr;
+				}
+				curr = ptr_of(succ);
+			}
+		}
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	typename __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::link_type
+		__concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::seek(const key_type& k) const
+	{
+		link_type pred = head;
+		link_type curr = 0;
+		for (int l = max_level - 1; l >= 0; --l) {
+			curr = next_of(pred, l);
+			while (curr && comp(key(curr), k)) {
+				// ժĽڵָѶᣬܴһ
+				if (!is_unlinked(curr))
+					pred = curr;
+				curr = next_of(curr, l);
+			}
+		}
+		return curr;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	bool __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::insert(const value_type& x)
+	{
+		guard g;
+		maybe_drain_deferred();
+
+		const key_type& k = KeyOfValue()(x);
+		link_type preds[max_level], succs[max_level];
+		int level = random_level();
+		link_type p = 0;
+		for (;;) {
+			if (find(k, preds, succs)) {
+				if (p)
+					destroy_node(p);
+				return false;
+			}
+			if (!p)
+				p = create_node(level, x);
+			for (int l = 0; l < level; ++l)
+				p->next[l].store(reinterpret_cast<uintptr_t>(succs[l]), std::memory_order_relaxed);
+			uintptr_t expected = reinterpret_cast<uintptr_t>(succs[0]);
+			if (preds[0]->next[0].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(p), std::memory_order_acq_rel))
+				break;
+		}
+		stamp_insert(p);
+		count.fetch_add(1, std::memory_order_relaxed);
+
+		// 㲹ڵڴڼ䱻ɾֹͣ
+		for (int l = 1; l < level; ++l) {
+			for (;;) {
+				uintptr_t old = p->next[l].load(std::memory_order_acquire);
+				if (is_marked(old) || p->erase_version.load(std::memory_order_acquire))
+					goto done;
+				link_type succ = succs[l];
+				if (ptr_of(old) != succ
+					&& !p->next[l].compare_exchange_strong(old, reinterpret_cast<uintptr_t>(succ), std::memory_order_acq_rel))
+					continue;
+				uintptr_t expected = reinterpret_cast<uintptr_t>(succ);
+				if (preds[l]->next[l].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(p), std::memory_order_acq_rel))
+					break;
+				find(k, preds, succs);
+				if (succs[0] != p)
+					goto done;
+			}
+		}
+	done:
+		release(p);
+		return true;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	bool __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::erase(const key_type& k)
+	{
+		guard g;
+		maybe_drain_deferred();
+
+		link_type preds[max_level], succs[max_level];
+		link_type victim;
+		for (;;) {
+			if (!find(k, preds, succs))
+				return false;
+			victim = succs[0];
+			// ɾ汾ֻܸһΣ³ɹ߼Ϊɾ
+			unsigned long long expected = 0;
+			if (victim->erase_version.compare_exchange_strong(expected, clock.fetch_add(1) + 1))
+				break;
+		}
+		count.fetch_sub(1, std::memory_order_relaxed);
+		unlink_or_defer(victim);
+		return true;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	unsigned long long __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::oldest_snapshot() const
+	{
+		if (overflow_snapshots.load() != 0)
+			return 0;
+		unsigned long long oldest = ~0ull;
+		for (int i = 0; i < snapshot_slots; ++i) {
+			unsigned long long v = snapshot_version[i].load();
+			if (v == slot_opening)
+				return 0;
+			if (v && v - 1 < oldest)
+				oldest = v - 1;
+		}
+		return oldest;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	int __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::open_snapshot(unsigned long long& v)
+	{
+		// ȵǼٶȡ汾ɾûпǼǣնİ汾ضɾ汾
+		open_snapshots.fetch_add(1);
+		int slot = 0;
+		for (; slot < snapshot_slots; ++slot) {
+			unsigned long long expected = 0;
+			if (snapshot_version[slot].load(std::memory_order_relaxed) == 0
+				&& snapshot_version[slot].compare_exchange_strong(expected, v ? v + 1 : slot_opening))
+				break;
+		}
+		if (slot == snapshot_slots)
+			overflow_snapshots.fetch_add(1);
+		if (!v) {
+			v = clock.load();
+			if (slot != snapshot_slots)
+				snapshot_version[slot].store(v + 1);
+		}
+		return slot;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	void __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::close_snapshot(int slot)
+	{
+		if (slot == snapshot_slots)
+			overflow_snapshots.fetch_sub(1);
+		else
+			snapshot_version[slot].store(0);
+		open_snapshots.fetch_sub(1);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	void __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::drain_deferred()
+	{
+		if (!deferred.load(std::memory_order_relaxed))
+			return;
+		link_type p = deferred.exchange(0, std::memory_order_acquire);
+		// ԱĳҪĽڵ´Ż
+		link_type keep_first = 0;
+		link_type keep_last = 0;
+		while (p) {
+			link_type next = p->deferred_next;
+			if (is_reclaimable(p)) {
+				unlink_node(p);
+			}
+			else {
+				p->deferred_next = keep_first;
+				keep_first = p;
+				if (!keep_last)
+					keep_last = p;
+			}
+			p = next;
+		}
+		if (keep_first)
+			push_deferred(keep_first, keep_last);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	void __concurrent_skiplist<Key, Value, KeyOfValue, Compare, Alloc>::free_all()
+	{
+		// ѱǵĽڵѽepochͷ
+		link_type p = next_of(head, 0);
+		while (p) {
+			link_type next = next_of(p, 0);
+			if (!is_unlinked(p))
+				destroy_node(p);
+			p = next;
+		}
+		__skiplist_deallocate_node<node_type, Alloc>(head);
+	}
+
+	/*
+	* concurrent_map: ΨһĲӳ䣬Ԫز󲻿޸
+	* ԸƵķʽȡֵɨͨget_snapshot()
+	*/
+	template<class Key, class T, class Alloc, class Compare = std::less<Key> > // class Alloc = alloc
+	class concurrent_map : public __concurrent_skiplist<Key, std::pair<const Key, T>,
+		__select1st<std::pair<const Key, T> >, Compare, Alloc> {
+	protected:
+		typedef __concurrent_skiplist<Key, std::pair<const Key, T>, __select1st<std::pair<const Key, T> >, Compare, Alloc> base;
+		typedef typename base::guard guard;
+
+	public:
+		typedef Key									key_type;
+		typedef T									mapped_type;
+		typedef std::pair<const Key, T>				value_type;
+
+		explicit concurrent_map(const Compare& c = Compare()) : base(c) {}
+
+		using base::insert;
+		bool insert(const key_type& k, const mapped_type& x) { return base::insert(value_type(k, x)); }
+		// ʱֵƵresult
+		bool find(const key_type& k, mapped_type& result) const {
+			guard g;
+			typename base::link_type p = this->find_alive(k);
+			if (!p)
+				return false;
+			result = p->value.second;
+			return true;
+		}
+	};
+
+	// concurrent_set: ΨһĲ򼯺
+	template<class Key, class Alloc, class Compare = std::less<Key> > // class Alloc = alloc
+	class concurrent_set : public __concurrent_skiplist<Key, Key, __identity<Key>, Compare, Alloc> {
+	protected:
+		typedef __concurrent_skiplist<Key, Key, __identity<Key>, Compare, Alloc> base;
+
+	public:
+		explicit concurrent_set(const Compare& c = Compare()) : base(c) {}
+	};
+
+}
+
+#endif // !_CHUSTL_CONCURRENTSKIPLIST_H_
\ No newline at end of file
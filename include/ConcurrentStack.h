@@ -0,0 +1,159 @@
+#pragma once
+
+#ifndef _CHUSTL_CONCURRENTSTACK_H_
+#define _CHUSTL_CONCURRENTSTACK_H_
+
+#include <atomic>
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Epoch.h"
+#include "SpscQueue.h"	// for __cache_line_size
+
+namespace ChuSTL {
+
+	template<class T>
+	struct __concurrent_stack_node : epoch_retired {
+		__concurrent_stack_node* next;	// ѹǰдã˺ٸı
+		T value;
+	};
+
+	/*
+	* concurrent_stack: Treiberջ
+	* pushpopֻheadһCASĽڵ㽻epochпܶ߳뿪ٽͷ
+	* ٽڶĽڵַᱻͷźãheadϵCASABAtop()ԪʱҲĶ
+	* вԪԸƵķʽȡsize()Ҫֻṩempty()
+	* ڵ㾭simple_alloc<node, Alloc>ãAllocɱ߳ͬʱ
+	*/
+	template<class T, class Alloc> // class Alloc = alloc
+	class concurrent_stack {
+	public:
+		typedef T						value_type;
+		typedef T&						reference;
+		typedef const T&				const_reference;
+		typedef size_t					size_type;
+
+	protected:
+		typedef __concurrent_stack_node<T> node;
+		typedef simple_alloc<node, Alloc> node_allocator;
+		typedef epoch_reclaimer<Alloc> epoch;
+		typedef typename epoch::guard guard;
+
+		alignas(__cache_line_size) std::atomic<node*> head;
+
+		static void destroy_node(node* p) {
+			destroy(&p->value);
+			node_allocator::deallocate(p);
+		}
+		static void reclaim_node(epoch_retired* p) {
+			destroy_node(static_cast<node*>(p));
+		}
+		// ժµǰջΪʱ0λٽ
+		node* unlink_top() {
+			node* p = head.load(std::memory_order_acquire);
+			while (p && !head.compare_exchange_weak(p, p->next, std::memory_order_acquire, std::memory_order_acquire))
+				;
+			return p;
+		}
+
+	private:
+		concurrent_stack(const concurrent_stack&);
+		concurrent_stack& operator=(const concurrent_stack&);
+
+	public:
+		concurrent_stack() : head(0) {}
+		// ʱ߳ʹ
+		~concurrent_stack() {
+			node* p = head.load(std::memory_order_relaxed);
+			while (p) {
+				node* next = p->next;
+				destroy_node(p);
+				p = next;
+			}
+		}
+
+		bool empty() const { return head.load(std::memory_order_acquire) == 0; }
+
+		void push(const value_type& x);
+		// ջresultΪʱfalse
+		bool top(value_type& result) const {
+			guard g;
+			node* p = head.load(std::memory_order_acquire);
+			if (!p)
+				return false;
+			result = p->value;
+			return true;
+		}
+		// ջΪʱʲôҲ
+		void pop() {
+			guard g;
+			node* p = unlink_top();
+			if (p)
+				epoch::retire(p);
+		}
+		// ջresultΪʱfalse
+		// Ƚepochٸƣguard֤ڵڷǰͷţ׳쳣ʱԪرڵ㲻ʧ
+		bool try_pop(value_type& result) {
+			guard g;
+			node* p = unlink_top();
+			if (!p)
+				return false;
+			epoch::retire(p);
+			result = p->value;
+			return true;
+		}
+		// һνȡջɶ׵Ĵдresultȡĸ
+		// ׳쳣ʱδдԪͬڵһepoch
+		template<class OutputIterator>
+		size_type pop_all(OutputIterator result);
+	};
+
+	template<class T, class Alloc>
+	void concurrent_stack<T, Alloc>::push(const value_type& x)
+	{
+		node* p = node_allocator::allocate();
+		try {
+			construct(&p->value, x);
+		}
+		catch (...) {
+			node_allocator::deallocate(p);
+			throw;
+		}
+		p->reclaim = &reclaim_node;
+		p->next = head.load(std::memory_order_relaxed);
+		while (!head.compare_exchange_weak(p->next, p, std::memory_order_release, std::memory_order_relaxed))
+			;
+	}
+
+	template<class T, class Alloc>
+	template<class OutputIterator>
+	typename concurrent_stack<T, Alloc>::size_type concurrent_stack<T, Alloc>::pop_all(OutputIterator result)
+	{
+		guard g;
+		node* p = head.exchange(0, std::memory_order_acquire);
+		size_type n = 0;
+		try {
+			while (p) {
+				// ߳̿ڶȡЩڵ㣬ͬepoch
+				*result = p->value;
+				++result;
+				++n;
+				node* next = p->next;
+				epoch::retire(p);
+				p = next;
+			}
+		}
+		catch (...) {
+			while (p) {
+				node* next = p->next;
+				epoch::retire(p);
+				p = next;
+			}
+			throw;
+		}
+		return n;
+	}
+
+}
+
+#endif // !_CHUSTL_CONCURRENTSTACK_H_
\ No newline at end of file
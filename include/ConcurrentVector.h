@@ -0,0 +1,298 @@
+#pragma once
+
+#ifndef _CHUSTL_CONCURRENTVECTOR_H_
+#define _CHUSTL_CONCURRENTVECTOR_H_
+
+#include <atomic>
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Iterator.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ChuSTL {
+
+	// log2(x)xΪ0
+	inline size_t __floor_log2(size_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+		return size_t(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, x);
+		return size_t(index);
+#else
+		size_t n = 0;
+		while (x >>= 1)
+			++n;
+		return n;
+#endif
+	}
+
+	// (, ±)ʾλõȡԪشӲƣڼʼЧ
+	template<class Container, class Value>
+	struct __concurrent_vector_iterator {
+		typedef random_access_iterator_tag						iterator_category;
+		typedef Value											value_type;
+		typedef Value*											pointer;
+		typedef Value&											reference;
+		typedef size_t											size_type;
+		typedef ptrdiff_t										difference_type;
+		typedef __concurrent_vector_iterator					self;
+
+		Container* c;
+		size_type index;
+
+		__concurrent_vector_iterator() : c(0), index(0) {}
+		__concurrent_vector_iterator(Container* x, size_type i) : c(x), index(i) {}
+		template<class C, class V>
+		__concurrent_vector_iterator(const __concurrent_vector_iterator<C, V>& x) : c(x.c), index(x.index) {}
+
+		reference operator*() const { return (*c)[index]; }
+		pointer operator->() const { return &(operator*()); }
+		self& operator++() {
+			++index;
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++index;
+			return tmp;
+		}
+		self& operator--() {
+			--index;
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			--index;
+			return tmp;
+		}
+		self& operator+=(difference_type n) {
+			index += n;
+			return *this;
+		}
+		self& operator-=(difference_type n) {
+			index -= n;
+			return *this;
+		}
+		self operator+(difference_type n) const { return self(c, index + n); }
+		self operator-(difference_type n) const { return self(c, index - n); }
+		difference_type operator-(const self& x) const { return difference_type(index - x.index); }
+		reference operator[](difference_type n) const { return (*c)[index + n]; }
+		bool operator==(const self& x) const { return index == x.index; }
+		bool operator!=(const self& x) const { return index != x.index; }
+		bool operator<(const self& x) const { return index < x.index; }
+	};
+
+	/*
+	* concurrent_vector: ֻĲvector
+	* dequemapƣԪطֶδţγααС̶Ԫ
+	* kfirst_segment_size * 2^kԪأ±굽(, ƫ)Ļֻһlog2
+	* push_back/grow_byfetch_addȡλãĶõ߳úCASװαCASʧͷԼõĶ
+	* ÿװװԪؿռ䣬˿Ԫؿռ߳һҲܿ
+	* ÿλøһǣϺλsize()ƽһδλ
+	* size()ֻͷϵԪأ[0, size())ڵԪڲڼʱȫȡ
+	* Ԫصĸƹ첻׳쳣Allocɱ߳ͬʱ
+	*/
+	template<class T, class Alloc> // class Alloc = alloc
+	class concurrent_vector {
+	public:
+		typedef T															value_type;
+		typedef T*															pointer;
+		typedef T&															reference;
+		typedef const T&													const_reference;
+		typedef size_t														size_type;
+		typedef ptrdiff_t													difference_type;
+		typedef __concurrent_vector_iterator<concurrent_vector, T>			iterator;
+		typedef __concurrent_vector_iterator<const concurrent_vector, const T>	const_iterator;
+
+	protected:
+		typedef std::atomic<unsigned char> flag_type;
+		typedef simple_alloc<value_type, Alloc> data_allocator;
+		typedef simple_alloc<flag_type, Alloc> flag_allocator;
+
+		enum {
+			first_segment_log = 3,
+			first_segment_size = 1 << first_segment_log,
+			max_segments = sizeof(size_t) * 8 - first_segment_log
+		};
+
+		std::atomic<pointer> segments[max_segments];
+		std::atomic<flag_type*> ready[max_segments];	// λõԪǷѹ
+		std::atomic<size_type> claimed;					// ѷɳȥλ
+		std::atomic<size_type> constructed;				// ͷϵԪ
+
+		static size_type segment_of(size_type i) {
+			return __floor_log2(i + first_segment_size) - first_segment_log;
+		}
+		static size_type segment_base(size_type k) {
+			return (size_type(first_segment_size) << k) - first_segment_size;
+		}
+		static size_type segment_size(size_type k) {
+			return size_type(first_segment_size) << k;
+		}
+
+		// ֤kãԪؿռ
+		pointer ensure_segment(size_type k) {
+			pointer p = segments[k].load(std::memory_order_acquire);
+			if (p)
+				return p;
+			return install_segment(k);
+		}
+		pointer install_segment(size_type k);
+
+		// iλõԪǷѹϣڵĶδʱҲfalse
+		bool is_ready(size_type i) const {
+			size_type k = segment_of(i);
+			flag_type* f = ready[k].load(std::memory_order_acquire);
+			return f && f[i - segment_base(k)].load(std::memory_order_seq_cst) != 0;
+		}
+		// [first, last)ѹϣconstructedƽһδλ
+		void publish(size_type first, size_type last);
+
+		// ֤[first, last)ڵĸξ
+		void ensure_range(size_type first, size_type last) {
+			if (first == last)
+				return;
+			for (size_type k = segment_of(first); k <= segment_of(last - 1); ++k)
+				ensure_segment(k);
+		}
+
+		void destroy_and_deallocate();
+
+	private:
+		concurrent_vector(const concurrent_vector&);
+		concurrent_vector& operator=(const concurrent_vector&);
+
+	public:
+		concurrent_vector() : claimed(0), constructed(0) {
+			for (size_type k = 0; k < max_segments; ++k) {
+				segments[k].store(0, std::memory_order_relaxed);
+				ready[k].store(0, std::memory_order_relaxed);
+			}
+		}
+		~concurrent_vector() { destroy_and_deallocate(); }
+
+		iterator begin() { return iterator(this, 0); }
+		const_iterator begin() const { return const_iterator(this, 0); }
+		iterator end() { return iterator(this, size()); }
+		const_iterator end() const { return const_iterator(this, size()); }
+
+		// ͷϵԪʱڹԪ
+		size_type size() const { return constructed.load(std::memory_order_acquire); }
+		bool empty() const { return size() == 0; }
+
+		// nСĳsize()Ľ
+		reference operator[](size_type n) {
+			size_type k = segment_of(n);
+			return segments[k].load(std::memory_order_acquire)[n - segment_base(k)];
+		}
+		const_reference operator[](size_type n) const {
+			size_type k = segment_of(n);
+			return segments[k].load(std::memory_order_acquire)[n - segment_base(k)];
+		}
+		reference front() { return (*this)[0]; }
+		reference back() { return (*this)[size() - 1]; }
+
+		// ׷һԪأָĵ
+		iterator push_back(const T& x) {
+			size_type i = claimed.fetch_add(1, std::memory_order_acq_rel);
+			size_type k = segment_of(i);
+			pointer p = ensure_segment(k) + (i - segment_base(k));
+			construct(p, x);
+			publish(i, i + 1);
+			return iterator(this, i);
+		}
+
+		// һȡnλòxʼָһԪصĵ
+		iterator grow_by(size_type n, const T& x) {
+			size_type first = claimed.fetch_add(n, std::memory_order_acq_rel);
+			ensure_range(first, first + n);
+			for (size_type i = first; i != first + n; ++i)
+				construct(&(*this)[i], x);
+			publish(first, first + n);
+			return iterator(this, first);
+		}
+		iterator grow_by(size_type n) {
+			return grow_by(n, T());
+		}
+
+		// ԤnԪصĸΣpush_back
+		void reserve(size_type n) {
+			ensure_range(0, n);
+		}
+
+		// ²κβ
+		void clear() {
+			destroy_and_deallocate();
+			claimed.store(0, std::memory_order_relaxed);
+			constructed.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	template<class T, class Alloc>
+	typename concurrent_vector<T, Alloc>::pointer concurrent_vector<T, Alloc>::install_segment(size_type k)
+	{
+		size_type n = segment_size(k);
+		// װǣpublish()ȡԪؿռֱʹ
+		if (!ready[k].load(std::memory_order_acquire)) {
+			flag_type* f = flag_allocator::allocate(n);
+			for (size_type i = 0; i != n; ++i)
+				new (&f[i]) flag_type(0);
+			flag_type* expected = 0;
+			if (!ready[k].compare_exchange_strong(expected, f, std::memory_order_acq_rel, std::memory_order_acquire))
+				flag_allocator::deallocate(f, n);
+		}
+		pointer p = data_allocator::allocate(n);
+		pointer expected = 0;
+		if (segments[k].compare_exchange_strong(expected, p, std::memory_order_acq_rel, std::memory_order_acquire))
+			return p;
+		// ߳װһ
+		data_allocator::deallocate(p, n);
+		return expected;
+	}
+
+	template<class T, class Alloc>
+	void concurrent_vector<T, Alloc>::publish(size_type first, size_type last)
+	{
+		for (size_type i = first; i != last; ++i) {
+			size_type k = segment_of(i);
+			ready[k].load(std::memory_order_relaxed)[i - segment_base(k)].store(1, std::memory_order_seq_cst);
+		}
+		// ƽseq_cst̸߳λԷıǣһܿᶼͣ
+		size_type c = constructed.load(std::memory_order_seq_cst);
+		while (is_ready(c)) {
+			if (constructed.compare_exchange_weak(c, c + 1, std::memory_order_seq_cst))
+				++c;
+		}
+	}
+
+	template<class T, class Alloc>
+	void concurrent_vector<T, Alloc>::destroy_and_deallocate()
+	{
+		for (size_type k = 0; k < max_segments; ++k) {
+			// Ԫؿռʧʱһοֻװ˾
+			flag_type* f = ready[k].load(std::memory_order_relaxed);
+			if (!f)
+				continue;
+			size_type n = segment_size(k);
+			pointer p = segments[k].load(std::memory_order_relaxed);
+			if (p) {
+				// ֻѹϵԪ
+				for (size_type i = 0; i != n; ++i)
+					if (f[i].load(std::memory_order_relaxed))
+						destroy(p + i);
+				data_allocator::deallocate(p, n);
+			}
+			flag_allocator::deallocate(f, n);
+			segments[k].store(0, std::memory_order_relaxed);
+			ready[k].store(0, std::memory_order_relaxed);
+		}
+	}
+
+}
+
+#endif // !_CHUSTL_CONCURRENTVECTOR_H_
\ No newline at end of file
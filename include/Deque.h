@@ -3,14 +3,56 @@
 #ifndef _CHUSTL_DEQUE_H
 #define _CHUSTL_DEQUE_H
 
+#include "Algorithm.h"	// for min, max
 #include "Allocator.h"
 #include "Alloc.h"
 #include "Iterator.h"
 #include "Uninitialized.h"
 
+#include <type_traits>	// for is_integral
+
 namespace ChuSTL {
 
-	template<class T, class Ref, class Ptr, size_t BufSize>
+	template<size_t N>
+	struct __static_log2 {
+		enum { value = 1 + __static_log2<N / 2>::value };
+	};
+	template<>
+	struct __static_log2<1> {
+		enum { value = 0 };
+	};
+	template<>
+	struct __static_log2<0> {
+		enum { value = 0 };
+	};
+
+	/*
+	* Сԣshift<T>::valueΪÿԪظlog2
+	* Ԫظ2ݣ±(, ƫ)Ļֻλ
+	*/
+	// BytesֽɵԪظ(ȡ2)һ
+	template<size_t Bytes>
+	struct deque_buffer_bytes {
+		template<class T>
+		struct shift {
+			enum { value = __static_log2<Bytes / sizeof(T)>::value };
+		};
+	};
+	// ÿNԪأN2ʱȡ
+	template<size_t N>
+	struct deque_buffer_elements {
+		template<class T>
+		struct shift {
+			enum { value = __static_log2<N>::value + ((N & (N - 1)) != 0 ? 1 : 0) };
+		};
+	};
+	// ĬԼ512ֽڣʱһҳһҳΪһ黺
+	// ĶAllocҳҪAllocаҳʹôҳ
+	typedef deque_buffer_bytes<512>					deque_buffer_default;
+	typedef deque_buffer_bytes<4096>				deque_buffer_page;
+	typedef deque_buffer_bytes<2 * 1024 * 1024>		deque_buffer_huge_page;
+
+	template<class T, class Ref, class Ptr, class BufPolicy>
 	struct __deque_iterator {
 		typedef T													value_type;
 		typedef Ptr													pointer;
@@ -20,8 +62,8 @@ namespace ChuSTL {
 
 		typedef random_access_iterator_tag							iterator_category;
 		typedef __deque_iterator									self;
-		typedef __deque_iterator<T, T&, T*, BufSize>				iterator;
-		typedef __deque_iterator<T, const T&, const T*, BufSize>	const_iterator;
+		typedef __deque_iterator<T, T&, T*, BufPolicy>				iterator;
+		typedef __deque_iterator<T, const T&, const T*, BufPolicy>	const_iterator;
 		typedef T**													map_pointer;
 
 		T* cur;				// õָеĵǰԪ
@@ -29,15 +71,16 @@ namespace ChuSTL {
 		T* last;			// õָβ
 		map_pointer node;	// ָܿ
 
+		__deque_iterator() : cur(0), first(0), last(0), node(0) {}
+
+		// Сڱȷ2
+		enum { buffer_shift = BufPolicy::template shift<T>::value };
+
 		static size_type buffer_size() {
-			return __deque_buf_size(BufSize, sizeof(value_type));
+			return size_type(1) << buffer_shift;
 		}
-		// nΪ0nʾbuffer sizeûԶ
-		// nΪ0ʾbuffer sizeʹĬֵ
-		// szԪشСsizeof(value_type)С512  512/sz
-		// sz512 1
-		inline size_type __deque_buf_size(size_type n, size_type sz) {
-			return n != 0 ? n : (sz < 512 ? size_type(512 / sz) : size_type(1));
+		static difference_type buffer_mask() {
+			return difference_type(buffer_size() - 1);
 		}
 
 		// лָĻ
@@ -48,9 +91,10 @@ namespace ChuSTL {
 		}
 
 		reference operator* () const { return *cur; }
-		pointer operator-> () const { return &(*cur) }
+		pointer operator-> () const { return &(*cur); }
 		difference_type operator-(const self& x) const {
-			return difference_type(buffer_size()) * (node - x.node - 1) +
+			// 2ݳΪλ
+			return (node - x.node - 1) * difference_type(buffer_size()) +
 				(cur - first) + (x.last - x.cur);
 		}
 
@@ -84,17 +128,15 @@ namespace ChuSTL {
 		// ȡֱԾ
 		self& operator+=(difference_type n) {
 			difference_type offset = n + (cur - first);
-			// Ŀλͬһڣֱƶ
-			if (offset >= 0 && offset < difference_type(buffer_size())) {
+			// ĿλͬһڣֱƶתΪ޷źȻΧ
+			if (size_type(offset) < buffer_size()) {
 				cur += n;
 			}
 			// ĿλòͬһлµĻƶ
+			// ƶԸȡǡΪĻƫƣõڵλ
 			else {
-				difference_type node_offset =
-					offset > 0 ? offset / difference_type(buffer_size())
-								: -difference_type((-offset - 1) / buffer_size()) - 1;
-				set_node(node + node_offset);
-				cur = first + (offset - node_offset * difference_type(buffer_size()));
+				set_node(node + (offset >> buffer_shift));
+				cur = first + (offset & buffer_mask());
 			}
 			return *this;
 		}
@@ -124,7 +166,14 @@ namespace ChuSTL {
 
 	};
 
-	template<class T, class Alloc, size_t BufSize = 0>
+	// deque::memory_usage()Ľֽڼ
+	struct deque_memory_usage {
+		size_t map_bytes;		// map
+		size_t buffer_bytes;	// üõȫ
+		size_t slack_bytes;		// ûдԪصĲ֣mapĿλĿλû
+	};
+
+	template<class T, class Alloc, class BufPolicy = deque_buffer_default>
 	class deque {
 	public :
 		typedef T			value_type;
@@ -134,7 +183,13 @@ namespace ChuSTL {
 		typedef size_t		size_type;
 		typedef ptrdiff_t	difference_type;
 
-		typedef __deque_iterator<T, T&, T*, BufSize> iterator;
+		typedef __deque_iterator<T, T&, T*, BufPolicy> iterator;
+
+		// ĬϱıûȶȽȳֻһ鼴ÿοԽ
+		enum { default_spare_limit = 2 };
+		// ýڵmapС1/map_shrink_ratioʱСmapԼΪڵı
+		// reallocate_map˺ֻԭmapУСԼ1/4ռʣ
+		enum { map_shrink_ratio = 8 };
 
 	protected:
 		typedef pointer* map_pointer;
@@ -145,23 +200,70 @@ namespace ChuSTL {
 		// map_sizemapڿɵָ
 		map_pointer map;
 		size_type map_size;
+		// ûͷŵĻ´Ҫ»ʱֱȡ
+		// ÿĿͷһĵַɵ
+		pointer spare_list;
+		size_type spare_count;
+		size_type spare_max;	// ౣĿ
 
 		// רռÿΪһԪ(ָ)ÿռ
-		typedef simple_alloc<value_tpe, Alloc> data_allocator;
+		typedef simple_alloc<value_type, Alloc> data_allocator;
 		typedef simple_alloc<pointer, Alloc> map_allocator;
 
+		static size_type buffer_size() {
+			return iterator::buffer_size();
+		}
+		static size_type initial_map_size() { return 8; }
+
+		// Сһָʱ޷뱸
+		static bool can_keep_spare() {
+			return buffer_size() * sizeof(value_type) >= sizeof(pointer);
+		}
+		pointer allocate_node() {
+			if (spare_list) {
+				pointer p = spare_list;
+				spare_list = *reinterpret_cast<pointer*>(p);
+				--spare_count;
+				return p;
+			}
+			return data_allocator::allocate(buffer_size());
+		}
+		void deallocate_node(pointer p) {
+			if (spare_count < spare_max && can_keep_spare()) {
+				*reinterpret_cast<pointer*>(p) = spare_list;
+				spare_list = p;
+				++spare_count;
+			}
+			else {
+				data_allocator::deallocate(p, buffer_size());
+			}
+		}
+		// ûn
+		void trim_spare(size_type n) {
+			while (spare_count > n) {
+				pointer p = spare_list;
+				spare_list = *reinterpret_cast<pointer*>(p);
+				--spare_count;
+				data_allocator::deallocate(p, buffer_size());
+			}
+		}
+
 
 	public:
+		deque()
+			: start(), finish(), map(0), map_size(0), spare_list(0), spare_count(0), spare_max(default_spare_limit)
+		{ create_map_and_nodes(0); }
 		deque(int n, const value_type& value) 
-			: start(0), finish(0), map(0), map_size(0) 
+			: start(), finish(), map(0), map_size(0), spare_list(0), spare_count(0), spare_max(default_spare_limit)
 		{ fill_initialize(n, value); }
+		~deque();
 
 		iterator begin() { return start; }
 		iterator end() { return finish; }
 		reference operator[](size_type n) { return start[difference_type(n)]; }
 		reference front() { return *begin(); }
 		reference back() { return *(end() - 1); }
-		size_type size() const { return end() - begin(); }
+		size_type size() const { return finish - start; }
 		size_type max_size() const { return size_type(-1); }
 		bool empty() { return end() == begin(); }
 
@@ -180,7 +282,7 @@ namespace ChuSTL {
 			// ͷбÿռʱֱڱÿռϹԪ
 			// µĻ
 			if (start.cur != start.first) {
-				construct(start.cur, value);
+				construct(start.cur - 1, value);
 				--start.cur;
 			}
 			else {
@@ -208,6 +310,21 @@ namespace ChuSTL {
 				pop_front_aux();
 		}
 		void clear();
+
+		// ûޣСʱͷŶĲ
+		size_type spare_limit() const { return spare_max; }
+		void set_spare_limit(size_type n) {
+			spare_max = n;
+			trim_spare(n);
+		}
+		// ǰıû
+		size_type spare_size() const { return spare_count; }
+		// ͷбûmapǡýڵ(˸һλ)
+		// dequeԱһ黺begin()/end()ʼָЧĽڵ
+		void shrink_to_fit();
+		// ĿǰռõĿռ䣬еɾݴ˾ʱshrink_to_fit
+		deque_memory_usage memory_usage() const;
+
 		iterator erase(iterator pos) {
 			iterator next = pos;
 			++next;
@@ -217,11 +334,11 @@ namespace ChuSTL {
 			// ƶ֮Ԫ
 			// עųƶϺԪ
 			if (index < (size() >> 1)) {
-				copy_backward(start, pos, next);
+				ChuSTL::copy_backward(start, pos, next);
 				pop_front();
 			}
 			else {
-				copy(next, finish, pos);
+				ChuSTL::copy(next, finish, pos);
 				pop_back();
 			}
 			return start + index;
@@ -244,7 +361,31 @@ namespace ChuSTL {
 				return insert_aux(pos, x);
 			}
 		}
-		
+		// pos֮ǰnxһ룬鹹
+		void insert(iterator pos, size_type n, const value_type& x);
+		// pos֮ǰ[first, last)ǰȣͬһ
+		template<class InputIterator>
+		void insert(iterator pos, InputIterator first, InputIterator last) {
+			insert_dispatch(pos, first, last, typename std::is_integral<InputIterator>::type());
+		}
+		// [first, last)׷ӵβ
+		template<class InputIterator>
+		void push_back_range(InputIterator first, InputIterator last) {
+			range_push_back(first, last, iterator_category(first));
+		}
+		// [first, last)ŵͷˣԭд򣬼ɺfront()Ϊ*first
+		template<class InputIterator>
+		void push_front_range(InputIterator first, InputIterator last) {
+			range_push_front(first, last, iterator_category(first));
+		}
+		// nxȡ
+		void assign(size_type n, const value_type& x);
+		// [first, last)ȡݣԪؾԸֵ
+		template<class InputIterator>
+		void assign(InputIterator first, InputIterator last) {
+			assign_aux(first, last, typename std::is_integral<InputIterator>::type());
+		}
+
 
 	protected:
 		void fill_initialize(size_type n, const value_type& value);
@@ -259,19 +400,157 @@ namespace ChuSTL {
 		}
 		void reserve_map_at_front(size_type nodes_to_add = 1) {
 			// ͷ˽ڵ㱸ÿռ䲻㣬ømap
-			if (nodes_to_add > first.node - map)
+			if (nodes_to_add > size_type(start.node - map))
 				reallocate_map(nodes_to_add, true);
 		}
 		void reallocate_map(size_type nodes_to_add, bool add_at_front);
+		// СΪnew_map_sizemapýڵ
+		void resize_map(size_type new_map_size);
+		// ռʹʱСmapmap»ʹеʧЧֻڱͻʹʧЧ
+		// clearԽpushм飬popmapʧʱԭmap׳쳣
+		void maybe_shrink_map() {
+			size_type num_nodes = finish.node - start.node + 1;
+			if (map_size > initial_map_size() && num_nodes * map_shrink_ratio < map_size) {
+				try {
+					resize_map(ChuSTL::max(initial_map_size(), 4 * num_nodes + 2));
+				}
+				catch (...) {}
+			}
+		}
 		void pop_back_aux();
 		void pop_front_aux();
 		iterator insert_aux(iterator pos, const value_type& x);
 
+		// ԤnԪصĿռ䲢úȫԤfinish/start
+		// ֻmapƶfinish/startɵڹɺ趨
+		iterator reserve_elements_at_back(size_type n) {
+			size_type vacancies = (finish.last - finish.cur) - 1;
+			if (n > vacancies)
+				new_elements_at_back(n - vacancies);
+			return finish + difference_type(n);
+		}
+		iterator reserve_elements_at_front(size_type n) {
+			size_type vacancies = start.cur - start.first;
+			if (n > vacancies)
+				new_elements_at_front(n - vacancies);
+			return start - difference_type(n);
+		}
+		void new_elements_at_back(size_type new_elements);
+		void new_elements_at_front(size_type new_elements);
+		// ʧʱͷԤĻ
+		void destroy_nodes_at_back(iterator new_finish) {
+			for (map_pointer n = finish.node + 1; n <= new_finish.node; ++n)
+				deallocate_node(*n);
+		}
+		void destroy_nodes_at_front(iterator new_start) {
+			for (map_pointer n = new_start.node; n < start.node; ++n)
+				deallocate_node(*n);
+		}
+
+		// °鴦dequeϵһ䣬ÿһռ䣬ԭָ汾
+		// copy/uninitialized_copyһδԪؾĻ߽
+		// ԴҲdequeʱÿͬʱԴĻ
+		template<class ForwardIterator>
+		static size_type block_length(const ForwardIterator&, size_type n) { return n; }
+		static size_type block_length(const iterator& i, size_type n) { return ChuSTL::min(n, size_type(i.last - i.cur)); }
+		template<class ForwardIterator>
+		static ForwardIterator block_begin(const ForwardIterator& i) { return i; }
+		static pointer block_begin(const iterator& i) { return i.cur; }
+		template<class ForwardIterator>
+		static void uninitialized_copy_block(ForwardIterator first, size_type n, pointer result) {
+			ForwardIterator last = first;
+			advance(last, n);
+			uninitialized_copy(first, last, result);
+		}
+		template<class ForwardIterator>
+		static void copy_block(ForwardIterator first, size_type n, pointer result) {
+			ForwardIterator last = first;
+			advance(last, n);
+			ChuSTL::copy(first, last, result);
+		}
+		// δʼ[result, result + n)ϹfirstnԪأfirst֮nλ
+		template<class ForwardIterator>
+		static ForwardIterator uninitialized_copy_blocks(ForwardIterator first, size_type n, iterator result);
+		// firstnԪظֵ[result, result + n)
+		template<class ForwardIterator>
+		static ForwardIterator copy_blocks(ForwardIterator first, size_type n, iterator result);
+		// ɺǰ[first, last)ֵresultΪβ
+		static void copy_backward_blocks(iterator first, iterator last, iterator result);
+		static void uninitialized_fill_blocks(iterator first, size_type n, const value_type& x);
+		static void fill_blocks(iterator first, size_type n, const value_type& x);
+
+		// ͷ/β˷firstnԪأһ
+		template<class ForwardIterator>
+		void append(ForwardIterator first, size_type n);
+		template<class ForwardIterator>
+		void prepend(ForwardIterator first, size_type n);
+		void fill_insert_aux(iterator pos, size_type n, const value_type& x);
+		template<class ForwardIterator>
+		void range_insert_aux(iterator pos, ForwardIterator first, ForwardIterator last, size_type n);
+
+		// ޷Ԥ֪ȣ׷
+		template<class InputIterator>
+		void range_push_back(InputIterator first, InputIterator last, input_iterator_tag) {
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+		template<class ForwardIterator>
+		void range_push_back(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+			append(first, size_type(distance(first, last)));
+		}
+		// ռһʱdequeУŵͷ
+		template<class InputIterator>
+		void range_push_front(InputIterator first, InputIterator last, input_iterator_tag) {
+			deque tmp;
+			tmp.range_push_back(first, last, input_iterator_tag());
+			prepend(tmp.begin(), tmp.size());
+		}
+		template<class ForwardIterator>
+		void range_push_front(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+			prepend(first, size_type(distance(first, last)));
+		}
+
+		template<class InputIterator>
+		void insert_dispatch(iterator pos, InputIterator first, InputIterator last, std::false_type) {
+			range_insert(pos, first, last, iterator_category(first));
+		}
+		template<class Integer>
+		void insert_dispatch(iterator pos, Integer n, Integer value, std::true_type) {
+			insert(pos, size_type(n), value_type(value));
+		}
+		// 嵽βʱֱ׷ӣͬռʱdeque
+		template<class InputIterator>
+		void range_insert(iterator pos, InputIterator first, InputIterator last, input_iterator_tag) {
+			if (pos.cur == finish.cur) {
+				range_push_back(first, last, input_iterator_tag());
+			}
+			else {
+				deque tmp;
+				tmp.range_push_back(first, last, input_iterator_tag());
+				range_insert(pos, tmp.begin(), tmp.end(), forward_iterator_tag());
+			}
+		}
+		template<class ForwardIterator>
+		void range_insert(iterator pos, ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+		template<class InputIterator>
+		void assign_aux(InputIterator first, InputIterator last, std::false_type) {
+			range_assign(first, last, iterator_category(first));
+		}
+		template<class Integer>
+		void assign_aux(Integer n, Integer value, std::true_type) {
+			assign(size_type(n), value_type(value));
+		}
+		template<class InputIterator>
+		void range_assign(InputIterator first, InputIterator last, input_iterator_tag);
+		template<class ForwardIterator>
+		void range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
 	};
 
 	// fill_initializeźdequeĽṹ(create_map_and_nodes)úԪصĳֵ
-	template<class T, class Alloc, size_t BufSizee>
-	void deque<T, Alloc, BufSizee>::fill_initialize(size_type n, const value_type& value) {
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::fill_initialize(size_type n, const value_type& value) {
 		create_map_and_nodes(n);
 		map_pointer cur;
 		//__STL_TRY
@@ -285,16 +564,16 @@ namespace ChuSTL {
 		catch (...) {}
 	}
 
-	template<class T, class Alloc, size_t BufSizee>
-	void deque<T, Alloc, BufSizee>::create_map_and_nodes(size_type num_elements) {
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::create_map_and_nodes(size_type num_elements) {
 		// ڵ = Ԫظ / ÿɵԪظ+ 1
 		// պһڵ
 		size_type num_nodes = num_elements / buffer_size() + 1;
 
 		// һmapɵĽڵ8ڵ+2
 		// ǰһڵ䣩
-		map_size = max(initial_map_size(), num_nodes + 2);
-		map = amp_allocator::allocate(map_size);
+		map_size = ChuSTL::max(initial_map_size(), num_nodes + 2);
+		map = map_allocator::allocate(map_size);
 
 		// ֱָͷβڵмλȷһ
 		map_pointer nstart = map + (map_size - num_nodes) / 2;
@@ -309,6 +588,12 @@ namespace ChuSTL {
 		}
 		catch (...) {
 			// "commit or rollback"
+			for (map_pointer n = nstart; n < cur; ++n)
+				deallocate_node(*n);
+			map_allocator::deallocate(map, map_size);
+			map = 0;
+			map_size = 0;
+			throw;
 		}
 
 		// ͷβλ
@@ -318,39 +603,42 @@ namespace ChuSTL {
 		finish.cur = finish.first + num_elements % buffer_size();
 	}
 
-	template<class T, class Alloc, size_t BufSizee>
-	void deque<T, Alloc, BufSizee>::push_back_aux(const value_type& value) {
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::push_back_aux(const value_type& value) {
 		value_type value_copy = value;
-		// Ƿmamp
+		// Ƿmamp߷Ȱѹmap
+		maybe_shrink_map();
 		reserve_map_at_back();
 		// µĻ
 		*(finish.node + 1) = allocate_node(); 
 		//__STL_TRY
 		try {
 			// 첢finishָ½ڵ㼰ָλ
-			_construct(finish.cur, value_copy);
+			construct(finish.cur, value_copy);
 			finish.set_node(finish.node + 1);
 			finish.cur = finish.first;
 		}
 		//__STL_UNWIND
 		catch (...) {
 			deallocate_node(*(finish.node + 1));
+			throw;
 		}
 	}
 
-	template<class T, class Alloc, size_t BufSizee>
-	void deque<T, Alloc, BufSizee>::push_front_aux(const value_type& value) {
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::push_front_aux(const value_type& value) {
 		value_type value_copy = value;
-		// Ƿmamp
+		// Ƿmamp߷Ȱѹmap
+		maybe_shrink_map();
 		reserve_map_at_front();
 		// µĻ
-		*(start.node - 1 1) = allocate_node();
+		*(start.node - 1) = allocate_node();
 		//__STL_TRY
 		try {
 			// startָ½ڵ㼰ָλò
 			start.set_node(start.node - 1);
 			start.cur = start.last - 1;
-			_construct(start.cur, value_copy);
+			construct(start.cur, value_copy);
 
 		}
 		catch (...) {
@@ -361,8 +649,8 @@ namespace ChuSTL {
 		}
 	}
 
-	template<class T, class Alloc, size_t BufSize>
-	void deque<T, Alloc, BufSize>::reallocate_map(size_type nodes_to_add, bool add_at_front) {
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::reallocate_map(size_type nodes_to_add, bool add_at_front) {
 		size_type old_num_nodes = finish.node - start.node + 1;
 		size_type new_num_nodes = old_num_nodes + nodes_to_add;
 
@@ -371,16 +659,16 @@ namespace ChuSTL {
 			new_nstart = map + (map_size - new_num_nodes) / 2
 				+ (add_at_front ? nodes_to_add : 0);
 			if (new_nstart < start.node)
-				copy(start.node, finish.node + 1, new_nstart);
+				ChuSTL::copy(start.node, finish.node + 1, new_nstart);
 			else
-				copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
+				ChuSTL::copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
 		}
 		else {
-			size_type new_map_size = map_size + max(map_size, nodes_to_add) + 2;
+			size_type new_map_size = map_size + ChuSTL::max(map_size, nodes_to_add) + 2;
 			map_pointer new_map = map_allocator::allocate(new_map_size);
 			new_nstart = new_map + (new_map_size - new_num_nodes) / 2
 				+ (add_at_front ? nodes_to_add : 0);
-			copy(start.node, finish.node + 1, new_nstart);
+			ChuSTL::copy(start.node, finish.node + 1, new_nstart);
 			map_allocator::deallocate(map, map_size);
 
 			map = new_map;
@@ -391,28 +679,72 @@ namespace ChuSTL {
 		finish.set_node(new_nstart + old_num_nodes - 1);
 	}
 
-	template<class T, class Alloc, size_t BufSize>
-	void deque<T, Alloc, BufSize>::pop_back_aux() {
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::resize_map(size_type new_map_size) {
+		size_type num_nodes = finish.node - start.node + 1;
+		map_pointer new_map = map_allocator::allocate(new_map_size);
+		map_pointer new_nstart = new_map + (new_map_size - num_nodes) / 2;
+		ChuSTL::copy(start.node, finish.node + 1, new_nstart);
+		map_allocator::deallocate(map, map_size);
+
+		map = new_map;
+		map_size = new_map_size;
+		start.set_node(new_nstart);
+		finish.set_node(new_nstart + num_nodes - 1);
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::shrink_to_fit() {
+		trim_spare(0);
+		size_type fit = ChuSTL::max(initial_map_size(), size_type(finish.node - start.node + 1) + 2);
+		if (map_size > fit)
+			resize_map(fit);
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	deque_memory_usage deque<T, Alloc, BufPolicy>::memory_usage() const {
+		size_type num_nodes = finish.node - start.node + 1;
+		size_type buffer_bytes = buffer_size() * sizeof(value_type);
+		deque_memory_usage usage;
+		usage.map_bytes = map_size * sizeof(pointer);
+		usage.buffer_bytes = (num_nodes + spare_count) * buffer_bytes;
+		usage.slack_bytes = (map_size - num_nodes) * sizeof(pointer)
+			+ usage.buffer_bytes - size() * sizeof(value_type);
+		return usage;
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::pop_back_aux() {
 		deallocate_node(finish.first);	// ͷβ
 		finish.set_node(finish.node - 1);	// finishָһһԪ
 		finish.cur = finish.last - 1;	
 		destroy(finish.cur);	// һԪ
 	}
 
-	template<class T, class Alloc, size_t BufSize>
-	void deque<T, Alloc, BufSize>::pop_front_aux() {
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::pop_front_aux() {
 		destroy(start.cur);	// ͷһԪ
 		deallocate_node(start.first);	// ͷͷ
 		start.set_node(start.node + 1);	// startָһĵһԪ
 		start.cur = start.first;
 	}
 
-	template<class T, class Alloc, size_t BufSize>
-	void deque<T, Alloc, BufSize>::clear() {
+	template<class T, class Alloc, class BufPolicy>
+	deque<T, Alloc, BufPolicy>::~deque() {
+		if (!map)
+			return;
+		clear();
+		data_allocator::deallocate(*start.node, buffer_size());
+		trim_spare(0);
+		map_allocator::deallocate(map, map_size);
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::clear() {
 		// ͷβ⻺ԪͷŻ
 		for (map_pointer node = start.node + 1; node < finish.node; ++node) {
 			destroy(*node, *node + buffer_size());
-			data_allocator::deallocate(*node, buffer_size());
+			deallocate_node(*node);
 		}
 
 		// ͷβֱʱȫԪ
@@ -421,17 +753,18 @@ namespace ChuSTL {
 		if (start.node != finish.node) {
 			destroy(start.cur, start.last);
 			destroy(finish.first, finish.cur);
-			data_allocator::deallocate(finish.first, buffer_size());
+			deallocate_node(finish.first);
 		}
 		else {
 			destroy(start.cur, finish.cur);
 		}
 		finish = start;
+		maybe_shrink_map();
 	}
 
-	template<class T, class Alloc, size_t BufSize>
-	deque<T, Alloc, BufSize>::iterator
-	deque<T, Alloc, BufSize>::erase(iterator first, iterator last)
+	template<class T, class Alloc, class BufPolicy>
+	typename deque<T, Alloc, BufPolicy>::iterator
+	deque<T, Alloc, BufPolicy>::erase(iterator first, iterator last)
 	{
 		// dequeֱclear
 		if (first == start && last == finish) {
@@ -446,28 +779,28 @@ namespace ChuSTL {
 			// ǰƶԪ
 			// עµstartfinishƶԪ
 			if (elems_before < (size() - n) / 2) {
-				copy_backward(start, first, last);
+				ChuSTL::copy_backward(start, first, last);
 				iterator new_start = start + n;
 				destroy(start, new_start);
 				for (map_pointer cur = start.node; cur < new_start.node; ++cur)
-					data_allocator::deallocate(*cur, buffer_size());
+					deallocate_node(*cur);
 				start = new_start;
 			}
 			else {
-				copy(last, finish, first);
+				ChuSTL::copy(last, finish, first);
 				iterator new_finish = finish - n;
 				destroy(new_finish, finish);
-				for (map_pointer cur = new_finish.node + 1, cur <= first; ++cur)
-					data_allocator::deallocate(*cur, buffer_size());
+				for (map_pointer cur = new_finish.node + 1; cur <= finish.node; ++cur)
+					deallocate_node(*cur);
 				finish = new_finish;
 			}
 			return start + elems_before;
 		}
 	}
 
-	template<class T, class Alloc, size_t BufSize>
-	deque<T, Alloc, BufSize>::iterator
-		deque<T, Alloc, BufSize>::insert_aux(iterator pos, const value_type& x)
+	template<class T, class Alloc, class BufPolicy>
+	typename deque<T, Alloc, BufPolicy>::iterator
+		deque<T, Alloc, BufPolicy>::insert_aux(iterator pos, const value_type& x)
 	{
 		difference_type index = pos - start;
 		value_type x_copy = x;
@@ -483,7 +816,7 @@ namespace ChuSTL {
 			pos = start + index;
 			iterator pos1 = pos;
 			++pos1;
-			copy(front2, pos1, front1);
+			ChuSTL::copy(front2, pos1, front1);
 		}
 		else {
 			push_back(back());
@@ -492,12 +825,386 @@ namespace ChuSTL {
 			iterator back2 = back1;
 			--back2;
 			pos = start + index;
-			copy_backward(pos, back2, back1);
+			ChuSTL::copy_backward(pos, back2, back1);
 		}
 		*pos = x_copy;
 		return pos;
 	}
 
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::new_elements_at_back(size_type new_elements) {
+		size_type new_nodes = (new_elements + buffer_size() - 1) / buffer_size();
+		// mapֻһ
+		reserve_map_at_back(new_nodes);
+		size_type i;
+		try {
+			for (i = 1; i <= new_nodes; ++i)
+				*(finish.node + i) = allocate_node();
+		}
+		catch (...) {
+			// "commit or rollback" semantics.
+			for (size_type j = 1; j < i; ++j)
+				deallocate_node(*(finish.node + j));
+			throw;
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::new_elements_at_front(size_type new_elements) {
+		size_type new_nodes = (new_elements + buffer_size() - 1) / buffer_size();
+		reserve_map_at_front(new_nodes);
+		size_type i;
+		try {
+			for (i = 1; i <= new_nodes; ++i)
+				*(start.node - i) = allocate_node();
+		}
+		catch (...) {
+			for (size_type j = 1; j < i; ++j)
+				deallocate_node(*(start.node - j));
+			throw;
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class ForwardIterator>
+	ForwardIterator deque<T, Alloc, BufPolicy>::uninitialized_copy_blocks(ForwardIterator first, size_type n, iterator result) {
+		iterator cur = result;
+		try {
+			while (n > 0) {
+				size_type len = block_length(first, ChuSTL::min(n, size_type(cur.last - cur.cur)));
+				uninitialized_copy_block(block_begin(first), len, cur.cur);
+				advance(first, len);
+				cur += difference_type(len);
+				n -= len;
+			}
+		}
+		catch (...) {
+			destroy(result, cur);
+			throw;
+		}
+		return first;
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class ForwardIterator>
+	ForwardIterator deque<T, Alloc, BufPolicy>::copy_blocks(ForwardIterator first, size_type n, iterator result) {
+		while (n > 0) {
+			size_type len = block_length(first, ChuSTL::min(n, size_type(result.last - result.cur)));
+			copy_block(block_begin(first), len, result.cur);
+			advance(first, len);
+			result += difference_type(len);
+			n -= len;
+		}
+		return first;
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::copy_backward_blocks(iterator first, iterator last, iterator result) {
+		difference_type n = last - first;
+		while (n > 0) {
+			// λڻͷĵǰһһβ
+			difference_type last_len = last.cur - last.first;
+			pointer last_end = last.cur;
+			if (last_len == 0) {
+				last_len = difference_type(buffer_size());
+				last_end = *(last.node - 1) + buffer_size();
+			}
+			difference_type result_len = result.cur - result.first;
+			pointer result_end = result.cur;
+			if (result_len == 0) {
+				result_len = difference_type(buffer_size());
+				result_end = *(result.node - 1) + buffer_size();
+			}
+			difference_type len = ChuSTL::min(n, ChuSTL::min(last_len, result_len));
+			ChuSTL::copy_backward(last_end - len, last_end, result_end);
+			last -= len;
+			result -= len;
+			n -= len;
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::uninitialized_fill_blocks(iterator first, size_type n, const value_type& x) {
+		iterator cur = first;
+		try {
+			while (n > 0) {
+				size_type len = ChuSTL::min(n, size_type(cur.last - cur.cur));
+				uninitialized_fill(cur.cur, cur.cur + len, x);
+				cur += difference_type(len);
+				n -= len;
+			}
+		}
+		catch (...) {
+			destroy(first, cur);
+			throw;
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::fill_blocks(iterator first, size_type n, const value_type& x) {
+		while (n > 0) {
+			size_type len = ChuSTL::min(n, size_type(first.last - first.cur));
+			ChuSTL::fill(first.cur, first.cur + len, x);
+			first += difference_type(len);
+			n -= len;
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class ForwardIterator>
+	void deque<T, Alloc, BufPolicy>::append(ForwardIterator first, size_type n) {
+		iterator new_finish = reserve_elements_at_back(n);
+		try {
+			uninitialized_copy_blocks(first, n, finish);
+		}
+		catch (...) {
+			destroy_nodes_at_back(new_finish);
+			throw;
+		}
+		finish = new_finish;
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class ForwardIterator>
+	void deque<T, Alloc, BufPolicy>::prepend(ForwardIterator first, size_type n) {
+		iterator new_start = reserve_elements_at_front(n);
+		try {
+			uninitialized_copy_blocks(first, n, new_start);
+		}
+		catch (...) {
+			destroy_nodes_at_front(new_start);
+			throw;
+		}
+		start = new_start;
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::insert(iterator pos, size_type n, const value_type& x) {
+		if (pos.cur == start.cur) {
+			iterator new_start = reserve_elements_at_front(n);
+			try {
+				uninitialized_fill_blocks(new_start, n, x);
+			}
+			catch (...) {
+				destroy_nodes_at_front(new_start);
+				throw;
+			}
+			start = new_start;
+		}
+		else if (pos.cur == finish.cur) {
+			iterator new_finish = reserve_elements_at_back(n);
+			try {
+				uninitialized_fill_blocks(finish, n, x);
+			}
+			catch (...) {
+				destroy_nodes_at_back(new_finish);
+				throw;
+			}
+			finish = new_finish;
+		}
+		else {
+			fill_insert_aux(pos, n, x);
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class ForwardIterator>
+	void deque<T, Alloc, BufPolicy>::range_insert(iterator pos, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		size_type n = distance(first, last);
+		if (pos.cur == start.cur)
+			prepend(first, n);
+		else if (pos.cur == finish.cur)
+			append(first, n);
+		else
+			range_insert_aux(pos, first, last, n);
+	}
+
+	// 뵥Ԫصinsert_auxͬƶǰԪؽٵһ
+	// ƳԪеԤδʼռ()еԭԪ(ֵ)
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::fill_insert_aux(iterator pos, size_type n, const value_type& x) {
+		const difference_type elems_before = pos - start;
+		const size_type length = size();
+		value_type x_copy = x;
+		if (elems_before < difference_type(length / 2)) {
+			iterator new_start = reserve_elements_at_front(n);
+			iterator old_start = start;
+			pos = start + elems_before;
+			try {
+				if (elems_before >= difference_type(n)) {
+					iterator start_n = start + difference_type(n);
+					uninitialized_copy_blocks(start, n, new_start);
+					start = new_start;
+					copy_blocks(start_n, size_type(elems_before) - n, old_start);
+					fill_blocks(pos - difference_type(n), n, x_copy);
+				}
+				else {
+					uninitialized_copy_blocks(start, size_type(elems_before), new_start);
+					iterator mid = new_start + elems_before;
+					try {
+						uninitialized_fill_blocks(mid, n - size_type(elems_before), x_copy);
+					}
+					catch (...) {
+						destroy(new_start, mid);
+						throw;
+					}
+					start = new_start;
+					fill_blocks(old_start, size_type(elems_before), x_copy);
+				}
+			}
+			catch (...) {
+				destroy_nodes_at_front(new_start);
+				throw;
+			}
+		}
+		else {
+			iterator new_finish = reserve_elements_at_back(n);
+			iterator old_finish = finish;
+			const difference_type elems_after = difference_type(length) - elems_before;
+			pos = finish - elems_after;
+			try {
+				if (elems_after > difference_type(n)) {
+					iterator finish_n = finish - difference_type(n);
+					uninitialized_copy_blocks(finish_n, n, finish);
+					finish = new_finish;
+					copy_backward_blocks(pos, finish_n, old_finish);
+					fill_blocks(pos, n, x_copy);
+				}
+				else {
+					uninitialized_fill_blocks(finish, n - size_type(elems_after), x_copy);
+					iterator mid = finish + (difference_type(n) - elems_after);
+					try {
+						uninitialized_copy_blocks(pos, size_type(elems_after), mid);
+					}
+					catch (...) {
+						destroy(finish, mid);
+						throw;
+					}
+					finish = new_finish;
+					fill_blocks(pos, size_type(elems_after), x_copy);
+				}
+			}
+			catch (...) {
+				destroy_nodes_at_back(new_finish);
+				throw;
+			}
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class ForwardIterator>
+	void deque<T, Alloc, BufPolicy>::range_insert_aux(iterator pos, ForwardIterator first, ForwardIterator last, size_type n) {
+		const difference_type elems_before = pos - start;
+		const size_type length = size();
+		if (elems_before < difference_type(length / 2)) {
+			iterator new_start = reserve_elements_at_front(n);
+			iterator old_start = start;
+			pos = start + elems_before;
+			try {
+				if (elems_before >= difference_type(n)) {
+					iterator start_n = start + difference_type(n);
+					uninitialized_copy_blocks(start, n, new_start);
+					start = new_start;
+					copy_blocks(start_n, size_type(elems_before) - n, old_start);
+					copy_blocks(first, n, pos - difference_type(n));
+				}
+				else {
+					uninitialized_copy_blocks(start, size_type(elems_before), new_start);
+					iterator mid = new_start + elems_before;
+					try {
+						first = uninitialized_copy_blocks(first, n - size_type(elems_before), mid);
+					}
+					catch (...) {
+						destroy(new_start, mid);
+						throw;
+					}
+					start = new_start;
+					copy_blocks(first, size_type(elems_before), old_start);
+				}
+			}
+			catch (...) {
+				destroy_nodes_at_front(new_start);
+				throw;
+			}
+		}
+		else {
+			iterator new_finish = reserve_elements_at_back(n);
+			iterator old_finish = finish;
+			const difference_type elems_after = difference_type(length) - elems_before;
+			pos = finish - elems_after;
+			try {
+				if (elems_after > difference_type(n)) {
+					iterator finish_n = finish - difference_type(n);
+					uninitialized_copy_blocks(finish_n, n, finish);
+					finish = new_finish;
+					copy_backward_blocks(pos, finish_n, old_finish);
+					copy_blocks(first, n, pos);
+				}
+				else {
+					ForwardIterator mid = first;
+					advance(mid, elems_after);
+					uninitialized_copy_blocks(mid, n - size_type(elems_after), finish);
+					iterator mid_finish = finish + (difference_type(n) - elems_after);
+					try {
+						uninitialized_copy_blocks(pos, size_type(elems_after), mid_finish);
+					}
+					catch (...) {
+						destroy(finish, mid_finish);
+						throw;
+					}
+					finish = new_finish;
+					copy_blocks(first, size_type(elems_after), pos);
+				}
+			}
+			catch (...) {
+				destroy_nodes_at_back(new_finish);
+				throw;
+			}
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	void deque<T, Alloc, BufPolicy>::assign(size_type n, const value_type& x) {
+		const size_type len = size();
+		if (n > len) {
+			fill_blocks(start, len, x);
+			insert(finish, n - len, x);
+		}
+		else {
+			erase(start + difference_type(n), finish);
+			fill_blocks(start, n, x);
+		}
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class InputIterator>
+	void deque<T, Alloc, BufPolicy>::range_assign(InputIterator first, InputIterator last, input_iterator_tag) {
+		// ȶԪһֵ׷
+		iterator cur = start;
+		for (; first != last && cur != finish; ++first, ++cur)
+			*cur = *first;
+		if (first == last)
+			erase(cur, finish);
+		else
+			range_push_back(first, last, input_iterator_tag());
+	}
+
+	template<class T, class Alloc, class BufPolicy>
+	template<class ForwardIterator>
+	void deque<T, Alloc, BufPolicy>::range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		const size_type n = distance(first, last);
+		const size_type len = size();
+		if (n > len) {
+			first = copy_blocks(first, len, start);
+			append(first, n - len);
+		}
+		else {
+			copy_blocks(first, n, start);
+			erase(start + difference_type(n), finish);
+		}
+	}
+
 }
 
 #endif // !_CHUSTL_DEQUE_H
@@ -0,0 +1,302 @@
+#pragma once
+
+#ifndef _CHUSTL_EPOCH_H_
+#define _CHUSTL_EPOCH_H_
+
+#include <atomic>
+#include <new>
+
+#include "Allocator.h"
+#include "Alloc.h"
+
+namespace ChuSTL {
+
+	// epochյĶԴΪࣺretire_nextͬһժĶreclaimͷ
+	struct epoch_retired {
+		epoch_retired* retire_next;
+		void (*reclaim)(epoch_retired*);
+	};
+
+	// epoch_reclaimer::stats()Ľڲ޸ʱֻǽֵ
+	struct epoch_stats {
+		unsigned long long epoch;	// ǰȫepoch
+		size_t threads;				// ѵǼǵ߳
+		size_t records;				// ̼߳¼ѽ߳¡ȴõ
+		size_t pending;				// ժδͷŵĶ
+	};
+
+	/*
+	* epoch_reclaimer: epochڴգ
+	* ÿ̳߳һ¼ٽʱǼǵǰȫepoch
+	* λٽ̶߳ѿȫepoch eʱǰe + 1
+	* epoch eժĶ󣬴ȫepoche + 2Ѳܱκ߳ãͷ
+	* ÿ̰߳ժʱepochѶֳһȫͷţҪ
+	*
+	* ߳ڵһνٽʱԶǼǣʱԶעҲregister_thread/unregister_threadǰ
+	* עʱδȫĶ¼£ƽepoch̻߳Ϊͷţ߳̽й©
+	* ֻҪû̳߳ͣٽУδͷŵĶ󲻳ÿ߳
+	* ͬһAllocһȫepoch¼Ӳͷţ̸߳
+	* epochȡ64λʵϲƣȽʱòֵС
+	*/
+	template<class Alloc> // class Alloc = alloc
+	class epoch_reclaimer {
+	protected:
+		typedef unsigned long long epoch_type;
+
+		struct record {
+			std::atomic<epoch_type> state;	// (epoch << 1) | Ƿλٽ
+			std::atomic<bool> in_use;
+			std::atomic<size_t> pending;	// limboеĶֻɳм¼߳޸
+			record* next;
+			unsigned depth;					// ٽǶײ̷ֻ߳
+			epoch_retired* limbo[3];		// ժʱepochֳ
+			epoch_type limbo_epoch[3];
+			size_t retired;					// ϴγƽepochժĶ
+		};
+
+		struct local_record {
+			record* rec;
+			local_record() : rec(0) {}
+			~local_record() {
+				if (rec)
+					release(rec);
+			}
+		};
+
+		enum { advance_interval = 64 };
+
+		static std::atomic<epoch_type> global_epoch;
+		static std::atomic<record*> records;
+
+		static local_record& local_holder() {
+			static thread_local local_record r;
+			return r;
+		}
+		static record* local() {
+			local_record& r = local_holder();
+			if (!r.rec)
+				r.rec = acquire();
+			return r.rec;
+		}
+		static record* acquire();
+		static void release(record* r);
+
+		static size_t free_list(epoch_retired* p) {
+			size_t n = 0;
+			while (p) {
+				epoch_retired* next = p->retire_next;
+				p->reclaim(p);
+				p = next;
+				++n;
+			}
+			return n;
+		}
+		// ͷrѾȫĸ󣬵r
+		static void reclaim(record* r, epoch_type e) {
+			size_t n = 0;
+			for (int i = 0; i < 3; ++i) {
+				if (r->limbo[i] && e - r->limbo_epoch[i] >= 2) {
+					n += free_list(r->limbo[i]);
+					r->limbo[i] = 0;
+				}
+			}
+			if (n)
+				r->pending.store(r->pending.load(std::memory_order_relaxed) - n, std::memory_order_relaxed);
+		}
+		// ʱӹѽ߳µļ¼ͷѾȫĶ
+		static void adopt_orphans(epoch_type e);
+		static bool try_advance();
+
+		template<class T>
+		static void deallocate_object(epoch_retired* p) {
+			T* q = static_cast<T*>(p);
+			destroy(q);
+			simple_alloc<T, Alloc>::deallocate(q);
+		}
+
+	public:
+		static void enter();
+		static void leave();
+		// pѴժλٽڡȫp->reclaim(p)
+		static void retire(epoch_retired* p);
+		// ͬϣpsimple_alloc<T, Alloc>ãȫ黹Alloc
+		template<class T>
+		static void retire_object(T* p) {
+			p->reclaim = &deallocate_object<T>;
+			retire(p);
+		}
+
+		// ǰΪǰ̵߳ǼǼ¼֮ٽҪ
+		static void register_thread() { local(); }
+		// ǰעǰ̣߳λٽ֮⡣֮ʹʱµǼ
+		static void unregister_thread() {
+			local_record& r = local_holder();
+			if (r.rec) {
+				release(r.rec);
+				r.rec = 0;
+			}
+		}
+		// ƽepochͷѾȫĶλٽ֮
+		// û߳λٽʱǰժĶȫͷ
+		static void flush();
+		static epoch_stats stats();
+
+		class guard {
+		public:
+			guard() { enter(); }
+			~guard() { leave(); }
+		private:
+			guard(const guard&);
+			guard& operator=(const guard&);
+		};
+	};
+
+	template<class Alloc>
+	std::atomic<typename epoch_reclaimer<Alloc>::epoch_type> epoch_reclaimer<Alloc>::global_epoch(0);
+	template<class Alloc>
+	std::atomic<typename epoch_reclaimer<Alloc>::record*> epoch_reclaimer<Alloc>::records(0);
+
+	template<class Alloc>
+	typename epoch_reclaimer<Alloc>::record* epoch_reclaimer<Alloc>::acquire()
+	{
+		// ȳԸѽ߳µļ¼
+		for (record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+			bool expected = false;
+			if (!r->in_use.load(std::memory_order_relaxed)
+				&& r->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+				return r;
+		}
+
+		record* r = simple_alloc<record, Alloc>::allocate();
+		new (&r->state) std::atomic<epoch_type>(0);
+		new (&r->in_use) std::atomic<bool>(true);
+		new (&r->pending) std::atomic<size_t>(0);
+		r->depth = 0;
+		for (int i = 0; i < 3; ++i) {
+			r->limbo[i] = 0;
+			r->limbo_epoch[i] = 0;
+		}
+		r->retired = 0;
+		record* head = records.load(std::memory_order_relaxed);
+		do {
+			r->next = head;
+		} while (!records.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+		return r;
+	}
+
+	template<class Alloc>
+	void epoch_reclaimer<Alloc>::release(record* r)
+	{
+		try_advance();
+		reclaim(r, global_epoch.load(std::memory_order_acquire));
+		// δȫĶ¼һ£adopt_orphansһʹͷ
+		r->in_use.store(false, std::memory_order_release);
+	}
+
+	template<class Alloc>
+	void epoch_reclaimer<Alloc>::adopt_orphans(epoch_type e)
+	{
+		for (record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+			if (r->in_use.load(std::memory_order_relaxed) || r->pending.load(std::memory_order_relaxed) == 0)
+				continue;
+			bool expected = false;
+			if (r->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+				reclaim(r, e);
+				r->in_use.store(false, std::memory_order_release);
+			}
+		}
+	}
+
+	template<class Alloc>
+	bool epoch_reclaimer<Alloc>::try_advance()
+	{
+		epoch_type e = global_epoch.load(std::memory_order_acquire);
+		// enter()еդԣյǼǵ߳Ҫôɨ迴Ҫôµepoch
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for (record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+			epoch_type s = r->state.load(std::memory_order_acquire);
+			if ((s & 1) && (s >> 1) != (e & (~0ull >> 1)))
+				return false;
+		}
+		if (!global_epoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel))
+			return false;
+		adopt_orphans(e + 1);
+		return true;
+	}
+
+	template<class Alloc>
+	void epoch_reclaimer<Alloc>::enter()
+	{
+		record* r = local();
+		if (r->depth++ != 0)
+			return;
+		epoch_type e = global_epoch.load(std::memory_order_acquire);
+		r->state.store((e << 1) | 1, std::memory_order_seq_cst);
+		// Ǽٽڵκζȡ֮ǰtry_advance()ɼ
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		reclaim(r, e);
+	}
+
+	template<class Alloc>
+	void epoch_reclaimer<Alloc>::leave()
+	{
+		record* r = local();
+		if (--r->depth == 0)
+			r->state.store(r->state.load(std::memory_order_relaxed) & ~epoch_type(1), std::memory_order_release);
+	}
+
+	template<class Alloc>
+	void epoch_reclaimer<Alloc>::retire(epoch_retired* p)
+	{
+		record* r = local();
+		epoch_type e = global_epoch.load(std::memory_order_acquire);
+		int i = int(e % 3);
+		size_t freed = 0;
+		if (r->limbo_epoch[i] != e) {
+			// һժe - 3磬Ѿȫ
+			freed = free_list(r->limbo[i]);
+			r->limbo[i] = 0;
+			r->limbo_epoch[i] = e;
+		}
+		p->retire_next = r->limbo[i];
+		r->limbo[i] = p;
+		r->pending.store(r->pending.load(std::memory_order_relaxed) + 1 - freed, std::memory_order_relaxed);
+		if (++r->retired >= advance_interval) {
+			r->retired = 0;
+			try_advance();
+			reclaim(r, global_epoch.load(std::memory_order_acquire));
+		}
+	}
+
+	template<class Alloc>
+	void epoch_reclaimer<Alloc>::flush()
+	{
+		record* r = local();
+		// ÿƽһΣһ㰲ȫˣȫȫҪƽ
+		// ߳µļ¼ƽɹʱһ
+		for (int i = 0; i < 3; ++i) {
+			try_advance();
+			reclaim(r, global_epoch.load(std::memory_order_acquire));
+		}
+	}
+
+	template<class Alloc>
+	epoch_stats epoch_reclaimer<Alloc>::stats()
+	{
+		epoch_stats s;
+		s.epoch = global_epoch.load(std::memory_order_acquire);
+		s.threads = 0;
+		s.records = 0;
+		s.pending = 0;
+		for (record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+			++s.records;
+			if (r->in_use.load(std::memory_order_relaxed))
+				++s.threads;
+			s.pending += r->pending.load(std::memory_order_relaxed);
+		}
+		return s;
+	}
+
+}
+
+#endif // !_CHUSTL_EPOCH_H_
\ No newline at end of file
@@ -0,0 +1,336 @@
+#pragma once
+
+#ifndef _CHUSTL_INTRUSIVELIST_H
+#define _CHUSTL_INTRUSIVELIST_H
+
+#include "Iterator.h"
+
+namespace ChuSTL {
+
+	// ǶûеֶΣһжhookͬʱλڶintrusive_list
+	// ƶʱ״̬¶Ǵδ״̬
+	struct intrusive_list_hook {
+		intrusive_list_hook* prev;
+		intrusive_list_hook* next;
+
+		intrusive_list_hook() : prev(0), next(0) {}
+		intrusive_list_hook(const intrusive_list_hook&) : prev(0), next(0) {}
+		intrusive_list_hook& operator=(const intrusive_list_hook&) { return *this; }
+
+		bool is_linked() const { return next != 0; }
+	};
+
+	// hookĵַڶĵַ
+	template<class T, intrusive_list_hook T::* Hook>
+	struct __intrusive_list_traits {
+		static size_t offset() {
+			// һķǿյַԱƫƣʸõַ
+			const T* base = reinterpret_cast<const T*>(size_t(1) << 12);
+			return size_t(reinterpret_cast<const char*>(&(base->*Hook)) - reinterpret_cast<const char*>(base));
+		}
+		static T* object_of(intrusive_list_hook* h) {
+			return reinterpret_cast<T*>(reinterpret_cast<char*>(h) - offset());
+		}
+		static intrusive_list_hook* hook_of(T& x) {
+			return &(x.*Hook);
+		}
+	};
+
+	template<class T, intrusive_list_hook T::* Hook, class Ref, class Ptr>
+	struct __intrusive_list_iterator {
+		typedef T															value_type;
+		typedef Ptr															pointer;
+		typedef Ref															reference;
+		typedef size_t														size_type;
+		typedef ptrdiff_t													difference_type;
+
+		typedef bidirectional_iterator_tag									iterator_category;
+		typedef __intrusive_list_iterator<T, Hook, Ref, Ptr>				self;
+		typedef __intrusive_list_iterator<T, Hook, T&, T*>					iterator;
+		typedef __intrusive_list_traits<T, Hook>							traits;
+
+		intrusive_list_hook* node;
+
+		__intrusive_list_iterator() : node(0) {}
+		__intrusive_list_iterator(intrusive_list_hook* x) : node(x) {}
+		__intrusive_list_iterator(const iterator& x) : node(x.node) {}
+
+		bool operator==(const self& x) const { return node == x.node; }
+		bool operator!=(const self& x) const { return node != x.node; }
+		reference operator*() const { return *traits::object_of(node); }
+		pointer operator->() const { return &(operator*()); }
+		self& operator++() {
+			node = node->next;
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+		self& operator--() {
+			node = node->prev;
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			--*this;
+			return tmp;
+		}
+	};
+
+	/*
+	* intrusive_list: ԶǶhookĻ״˫
+	* ÷Ϊintrusive_list<conn, &conn::idle_hook>ʹ߹listҲͷκοռ
+	* listͬβ˵Ŀհ׽ڵ㼴listheadlist󲻿ɸ
+	* ǰȴڵĸlistƳclear()listֻӣ
+	*/
+	template<class T, intrusive_list_hook T::* Hook>
+	class intrusive_list {
+	public:
+		typedef T																value_type;
+		typedef T*																pointer;
+		typedef T&																reference;
+		typedef const T&														const_reference;
+		typedef size_t															size_type;
+		typedef ptrdiff_t														difference_type;
+		typedef __intrusive_list_iterator<T, Hook, T&, T*>						iterator;
+		typedef __intrusive_list_iterator<T, Hook, const T&, const T*>		const_iterator;
+
+	protected:
+		typedef intrusive_list_hook* link_type;
+		typedef __intrusive_list_traits<T, Hook> traits;
+
+		intrusive_list_hook head;
+		size_type len;
+
+		void empty_initialize() {
+			head.next = &head;
+			head.prev = &head;
+			len = 0;
+		}
+
+		// [first, last)Ƶposition֮ǰlenɵ߸
+		void transfer(iterator position, iterator first, iterator last) {
+			if (position != last) {
+				last.node->prev->next = position.node;
+				first.node->prev->next = last.node;
+				position.node->prev->next = first.node;
+				link_type tmp = position.node->prev;
+				position.node->prev = last.node->prev;
+				last.node->prev = first.node->prev;
+				first.node->prev = tmp;
+			}
+		}
+
+		static void unlink(link_type p) {
+			p->prev->next = p->next;
+			p->next->prev = p->prev;
+			p->prev = 0;
+			p->next = 0;
+		}
+
+	private:
+		intrusive_list(const intrusive_list&);
+		intrusive_list& operator=(const intrusive_list&);
+
+	public:
+		intrusive_list() { empty_initialize(); }
+		~intrusive_list() { clear(); }
+
+		iterator begin() { return head.next; }
+		const_iterator begin() const { return head.next; }
+		iterator end() { return &head; }
+		const_iterator end() const { return const_cast<link_type>(&head); }
+		bool empty() const { return head.next == &head; }
+		size_type size() const { return len; }
+		reference front() { return *begin(); }
+		reference back() { return *(--end()); }
+
+		// ָxĵxλڱlist
+		static iterator iterator_to(T& x) { return traits::hook_of(x); }
+
+		// xѾλһʹͬһhooklist
+		iterator insert(iterator position, T& x) {
+			link_type tmp = traits::hook_of(x);
+			tmp->next = position.node;
+			tmp->prev = position.node->prev;
+			position.node->prev->next = tmp;
+			position.node->prev = tmp;
+			++len;
+			return tmp;
+		}
+		void push_front(T& x) { insert(begin(), x); }
+		void push_back(T& x) { insert(end(), x); }
+		iterator erase(iterator position) {
+			link_type next_node = position.node->next;
+			unlink(position.node);
+			--len;
+			return next_node;
+		}
+		// ֻƾƳO(1)
+		void erase(T& x) { erase(iterator_to(x)); }
+		void pop_front() { erase(begin()); }
+		void pop_back() { erase(--end()); }
+		void clear(); // ж
+		template<class Predicate>
+		void remove_if(Predicate pred); // ƳʹpredΪж
+		void unique(); // Ƴֵͬ
+
+		// xӺpositonָλ֮ǰx벻ͬ*thisO(1)
+		void splice(iterator position, intrusive_list& x) {
+			if (!x.empty()) {
+				transfer(position, x.begin(), x.end());
+				len += x.len;
+				x.len = 0;
+			}
+		}
+		// iָӺpositionָλ֮ǰpositioniָͬһlist
+		void splice(iterator position, intrusive_list& x, iterator i) {
+			iterator j = i;
+			++j;
+			if (position == i || position == j)
+				return;
+			transfer(position, i, j);
+			++len;
+			--x.len;
+		}
+		// [first, last)ڵжӺpositionָλ֮ǰpositionλ[first, last)֮
+		// һlistʱҪ䳤ȣ֪ʱӦʹİ汾
+		void splice(iterator position, intrusive_list& x, iterator first, iterator last) {
+			if (first == last)
+				return;
+			size_type n = 0;
+			if (&x != this)
+				for (iterator i = first; i != last; ++i)
+					++n;
+			splice(position, x, first, last, n);
+		}
+		// ͬϣnΪ[first, last)ڵĶO(1)
+		void splice(iterator position, intrusive_list& x, iterator first, iterator last, size_type n) {
+			if (first == last)
+				return;
+			transfer(position, first, last);
+			if (&x != this) {
+				len += n;
+				x.len -= n;
+			}
+		}
+		void swap(intrusive_list& x); // headǶlist֮УͨӺϽ
+		void merge(intrusive_list& x); // xϲ*thisϣlistݱȾ
+		void reverse(); // *this
+		void sort(); // ȶĹ鲢ֻӣÿռ
+	};
+
+	template<class T, intrusive_list_hook T::* Hook>
+	void intrusive_list<T, Hook>::clear() {
+		link_type cur = head.next;
+		while (cur != &head) {
+			link_type next = cur->next;
+			cur->prev = 0;
+			cur->next = 0;
+			cur = next;
+		}
+		empty_initialize();
+	}
+	template<class T, intrusive_list_hook T::* Hook>
+	template<class Predicate>
+	void intrusive_list<T, Hook>::remove_if(Predicate pred) {
+		for (link_type cur = head.next; cur != &head; ) {
+			link_type next = cur->next;
+			if (pred(*traits::object_of(cur))) {
+				unlink(cur);
+				--len;
+			}
+			cur = next;
+		}
+	}
+	template<class T, intrusive_list_hook T::* Hook>
+	void intrusive_list<T, Hook>::unique() {
+		if (empty())
+			return;
+		link_type first = head.next;
+		for (link_type cur = first->next; cur != &head; ) {
+			link_type next = cur->next;
+			if (*traits::object_of(first) == *traits::object_of(cur)) {
+				unlink(cur);
+				--len;
+			}
+			else {
+				first = cur;
+			}
+			cur = next;
+		}
+	}
+	template<class T, intrusive_list_hook T::* Hook>
+	void intrusive_list<T, Hook>::swap(intrusive_list& x) {
+		intrusive_list tmp;
+		tmp.splice(tmp.end(), *this);
+		splice(end(), x);
+		x.splice(x.end(), tmp);
+	}
+	template<class T, intrusive_list_hook T::* Hook>
+	void intrusive_list<T, Hook>::merge(intrusive_list& x) {
+		if (this == &x)
+			return;
+		iterator first1 = begin();
+		iterator last1 = end();
+		iterator first2 = x.begin();
+		iterator last2 = x.end();
+
+		while (first1 != last1 && first2 != last2) {
+			if (*first2 < *first1) {
+				iterator next = first2;
+				transfer(first1, first2, ++next);
+				first2 = next;
+			}
+			else {
+				++first1;
+			}
+		}
+		if (first2 != last2)
+			transfer(last1, first2, last2);
+		len += x.len;
+		x.len = 0;
+	}
+	template<class T, intrusive_list_hook T::* Hook>
+	void intrusive_list<T, Hook>::reverse() {
+		if (len < 2)
+			return;
+		// ÿڵprev/nextheadҲһ
+		link_type cur = &head;
+		do {
+			link_type tmp = cur->next;
+			cur->next = cur->prev;
+			cur->prev = tmp;
+			cur = tmp;
+		} while (cur != &head);
+	}
+	template<class T, intrusive_list_hook T::* Hook>
+	void intrusive_list<T, Hook>::sort() {
+		if (len < 2)
+			return;
+		// list::sortͬ鲢ݴlistջ
+		intrusive_list carry;
+		intrusive_list counter[64];
+		int fill = 0;
+		while (!empty()) {
+			carry.splice(carry.begin(), *this, begin());
+			int i = 0;
+			while (i < fill && !counter[i].empty()) {
+				counter[i].merge(carry);
+				carry.swap(counter[i++]);
+			}
+			carry.swap(counter[i]);
+			if (i == fill)
+				++fill;
+		}
+
+		for (int i = 1; i < fill; i++)
+			counter[i].merge(counter[i - 1]);
+		swap(counter[fill - 1]);
+	}
+
+}
+
+#endif // !_CHUSTL_INTRUSIVELIST_H
\ No newline at end of file
@@ -4,16 +4,19 @@
 #define _CHUSTL_ITERATOR_H_
 
 #include <cstddef>
+#include <type_traits>
 #include "TypeTraits.h"
 
 namespace ChuSTL {
 
-	//Ϊõ(tag types)
+	//Ϊõ(tag types)
 	struct input_iterator_tag {};
 	struct output_iterator_tag {};
 	struct forward_iterator_tag : public input_iterator_tag {};
 	struct bidirectional_iterator_tag : public forward_iterator_tag {};
 	struct random_access_iterator_tag : public bidirectional_iterator_tag {};
+	// ԪڴţԾto_addressȡԭָ룬memmoveδ
+	struct contiguous_iterator_tag : public random_access_iterator_tag {};
 
 
 
@@ -122,6 +125,50 @@ namespace ChuSTL {
 		return static_cast<typename iterator_traits<Iterator>::difference_type*>(0);
 	}
 
+	// жϵǷΪ
+	template<class Iterator>
+	struct __is_contiguous_iterator
+		: std::is_convertible<typename iterator_traits<Iterator>::iterator_category, contiguous_iterator_tag> {};
+
+	// ǷṩԱto_address()
+	template<class Iterator>
+	class __has_to_address {
+		template<class I>
+		static std::true_type test(decltype(&I::to_address));
+		template<class I>
+		static std::false_type test(...);
+	public:
+		typedef decltype(test<Iterator>(0)) type;
+	};
+
+	template<class Iterator>
+	inline typename iterator_traits<Iterator>::pointer
+		__to_address(const Iterator& it, std::true_type) {
+		return it.to_address();
+	}
+
+	template<class Iterator>
+	inline typename iterator_traits<Iterator>::pointer
+		__to_address(const Iterator& it, std::false_type) {
+		return it.operator->();
+	}
+
+	/*
+	* to_address : ȡָλõԭָ룬βͬ
+	* ԭָԭأ͵ĵṩԱto_address()ʱ(β˽ʱʹ)operator->()
+	* 㷨һChuSTL::to_address޶ãADLC++20std::to_address
+	*/
+	template<class T>
+	inline T* to_address(T* p) {
+		return p;
+	}
+
+	template<class Iterator>
+	inline typename iterator_traits<Iterator>::pointer
+		to_address(const Iterator& it) {
+		return __to_address(it, typename __has_to_address<Iterator>::type());
+	}
+
 	/*
 	* advance : ڶʵĳṩֵذ汾
 	*/
@@ -156,7 +203,7 @@ namespace ChuSTL {
 	*/
 	template<class InputIterator, class Distance>
 	inline void advance(InputIterator& it, Distance n) {
-		__advance(it, n, iterator_traits<InputIterator>::iterator_category());
+		__advance(it, n, typename iterator_traits<InputIterator>::iterator_category());
 	}
 
 	/*
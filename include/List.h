@@ -3,6 +3,9 @@
 #ifndef _CHUSTL_LIST_H
 #define _CHUSTL_LIST_H
 
+#include <functional>	// for equal_to
+#include <thread>
+
 #include "Allocator.h"
 #include "Alloc.h"
 #include "Iterator.h"
@@ -70,19 +73,123 @@ namespace ChuSTL {
 		}
 	};
 
+	// list::removeνʣԪصvalue
+	template<class T>
+	struct __list_equal_value {
+		const T& value;
+		explicit __list_equal_value(const T& x) : value(x) {}
+		bool operator()(const T& x) const { return x == value; }
+	};
+
+	// ڵﵽֵʱlist::sortΪȰѽڵָռһ
+	const size_t __list_sort_relink_threshold = 1024;
+
+	// Խڵָ[first, last)ڵֱӲȶ
+	template<class Link>
+	void __list_insertion_sort(Link* first, Link* last) {
+		if (first == last)
+			return;
+		for (Link* i = first + 1; i != last; ++i) {
+			Link value = *i;
+			Link* j = i;
+			for (; j != first && value->data < (*(j - 1))->data; --j)
+				*j = *(j - 1);
+			*j = value;
+		}
+	}
+
+	// [first, middle)[middle, last)鲢resultʱǰ
+	template<class Link>
+	void __list_merge_links(Link* first, Link* middle, Link* last, Link* result) {
+		Link* i = first;
+		Link* j = middle;
+		while (i != middle && j != last)
+			*result++ = ((*j)->data < (*i)->data) ? *j++ : *i++;
+		while (i != middle)
+			*result++ = *i++;
+		while (j != last)
+			*result++ = *j++;
+	}
+
+	// Եϵȶ鲢bufferٿlast - firstָ
+	// ָ뻺ģÿһ˹鲢˳ȡ
+	template<class Link>
+	void __list_sort_links(Link* first, Link* last, Link* buffer) {
+		const size_t run = 32;
+		size_t n = size_t(last - first);
+		for (size_t i = 0; i < n; i += run)
+			__list_insertion_sort(first + i, first + (n - i < run ? n : i + run));
+
+		Link* from = first;
+		Link* to = buffer;
+		for (size_t width = run; width < n; width *= 2) {
+			for (size_t i = 0; i < n; i += 2 * width) {
+				size_t middle = n - i < width ? n : i + width;
+				size_t end = n - middle < width ? n : middle + width;
+				__list_merge_links(from + i, from + middle, from + end, to + i);
+			}
+			Link* tmp = from;
+			from = to;
+			to = tmp;
+		}
+		if (from != first)
+			for (size_t i = 0; i < n; ++i)
+				first[i] = from[i];
+	}
+
+	// [first, last)ΪthreadsΣһ߳鲢
+	// Ƚϲִ߳У׳쳣
+	template<class Link>
+	void __list_parallel_sort_links(Link* first, Link* last, Link* buffer, size_t threads) {
+		size_t n = size_t(last - first);
+		if (threads <= 1 || n < 2 * __list_sort_relink_threshold) {
+			__list_sort_links(first, last, buffer);
+			return;
+		}
+		Link* middle = first + n / 2;
+		size_t left_threads = threads / 2;
+		// ޷ٽ߳ʱڱ߳ǰΣ쳣пjoin߳
+		std::thread left;
+		try {
+			left = std::thread(&__list_parallel_sort_links<Link>, first, middle, buffer, left_threads);
+		}
+		catch (...) {
+			__list_sort_links(first, middle, buffer);
+		}
+		__list_parallel_sort_links(middle, last, buffer + (middle - first), threads - left_threads);
+		if (left.joinable())
+			left.join();
+
+		__list_merge_links(first, middle, last, buffer);
+		for (size_t i = 0; i < n; ++i)
+			first[i] = buffer[i];
+	}
+
 	// SGI listһ״˫
 	template<class T, class Alloc> // Alloc = alloc
 	class list {
+	protected:
+		typedef __list_node<T> list_node;
+
 	public:
 		typedef list_node* link_type;
+		typedef T											value_type;
+		typedef T*											pointer;
+		typedef T&											reference;
+		typedef const T&									const_reference;
+		typedef size_t										size_type;
+		typedef ptrdiff_t									difference_type;
+		typedef __list_iterator<T, T&, T*>					iterator;
+		typedef __list_iterator<T, const T&, const T*>		const_iterator;
 
 	protected:
-		typedef __list_node<T> list_node;
 		// רռÿһڵС
 		typedef simple_alloc<list_node, Alloc> list_node_allocator;
 		// һָʾ״˫
 		// nodeָβ˵һհ׽ڵ㣬STLǰպ
 		link_type node;
+		// ԪظɾӺϲͬάsize()ΪO(1)
+		size_type len;
 
 	protected:
 		// áͷš졢ٽڵ
@@ -90,7 +197,7 @@ namespace ChuSTL {
 			return list_node_allocator::allocate();
 		}
 		void put_node(link_type p) {
-			link_node_allocator::deallocate(p);
+			list_node_allocator::deallocate(p);
 		}
 		link_type create_node(const T& x) {
 			link_type p = get_node();
@@ -98,16 +205,45 @@ namespace ChuSTL {
 			return p;
 		}
 		void destroy_node(link_type p) {
-			destroy(p->data);
+			destroy(&p->data);
 			put_node(p);
 		}
+		// ͷnext0βһժµĽڵ㣺Ԫأٰڵһν
+		void destroy_chain(link_type p) {
+			void* first = 0;
+			void** tail = &first;
+			void* last = 0;
+			size_type n = 0;
+			while (p) {
+				link_type next = link_type(p->next);
+				destroy(&p->data);
+				// Ԫڵ㿪ͷĿռһڵָ
+				*tail = p;
+				tail = static_cast<void**>(static_cast<void*>(p));
+				last = p;
+				++n;
+				p = next;
+			}
+			*tail = 0;
+			list_node_allocator::deallocate_chain(first, last, n);
+		}
+		// curժ£ӵtailβĽڵ㴮֮
+		void unlink_to_chain(link_type cur, link_type*& tail) {
+			link_type(cur->prev)->next = cur->next;
+			link_type(cur->next)->prev = cur->prev;
+			--len;
+			*tail = cur;
+			tail = (link_type*)&cur->next;
+		}
 
 		void empty_initialize() {
 			node = get_node();
 			node->next = node;
 			node->prev = node;
+			len = 0;
 		}
 
+		// [first, last)Ƶposition֮ǰlenɵ߸
 		void transfer(iterator position, iterator first, iterator last) {
 			if (position != last) {
 				(*(link_type((*last.node).prev))).next = position.node;
@@ -128,11 +264,7 @@ namespace ChuSTL {
 		bool empty() { return node == node->next; }
 		reference front() { return *begin(); }
 		reference back() { return *(--end()); }
-		size_type size() const {
-			size_type result = 0;
-			distance(begin(), end(), result);
-			return result;
-		}
+		size_type size() const { return len; }
 
 		iterator insert(iterator position, const T& x) {
 			link_type tmp = create_node(x);
@@ -140,6 +272,7 @@ namespace ChuSTL {
 			tmp->prev = position.node->prev;
 			(link_type(position.node->prev))->next = tmp;
 			position.node->prev = tmp;
+			++len;
 			return tmp;
 		}
 		void push_front(const T& x) { insert(begin(), x); }
@@ -149,38 +282,81 @@ namespace ChuSTL {
 			link_type prev_node = link_type(position.node->prev);
 			prev_node->next = next_node;
 			next_node->prev = prev_node;
-			destroy(position.node);
+			destroy_node(position.node);
+			--len;
 			return iterator(next_node);
 		}
 		void pop_front() { erase(begin()); }
 		void pop_back() { erase(--end()); }
 		void clear(); // нڵ
+		// ƳȽڵȫժ£һͷ
+		// valuelistеԪأpred׳쳣ʱժµĽڵҲᱻͷ
 		void remove(const T& value); // ֵΪvalueԪƳ
+		template<class Predicate>
+		void remove_if(Predicate pred); // ʹpredΪԪƳ
 		void unique(); // ƳֵͬԪ
+		template<class BinaryPredicate>
+		void unique(BinaryPredicate binary_pred); // Ƴʹbinary_predΪԪ
 
-		// xӺpositonָλ֮ǰx벻ͬ*this
+		// xӺpositonָλ֮ǰx벻ͬ*thisO(1)
 		void splice(iterator position, list& x) {
-			if (!x.empty())
-				transfer(postion, x.begin(), x.end());
+			if (!x.empty()) {
+				transfer(position, x.begin(), x.end());
+				len += x.len;
+				x.len = 0;
+			}
 		}
 		// iָԪؽӺpositionָλ֮ǰpositioniָͬһlist
-		void splice(iterator position, list&, iterator i) {
+		void splice(iterator position, list& x, iterator i) {
 			iterator j = i;
 			++j;
 			if (position == i || position == j)
 				return;
 			transfer(position, i, j);
+			++len;
+			--x.len;
 		}
 		// [first, last)ڵԪؽӺpositionָλ֮ǰ
 		// position[first, last)ָͬһlist
 		// positionλ[first, last)֮
-		void splice(iterator position, list&, iterator first, iterator last) {
-			if (first != last)
-				transfer(position, first, last);
+		// һlistʱҪ䳤ȣ֪ʱӦʹİ汾
+		void splice(iterator position, list& x, iterator first, iterator last) {
+			if (first == last)
+				return;
+			size_type n = 0;
+			if (&x != this)
+				for (iterator i = first; i != last; ++i)
+					++n;
+			splice(position, x, first, last, n);
+		}
+		// ͬϣnΪ[first, last)ڵԪظO(1)
+		void splice(iterator position, list& x, iterator first, iterator last, size_type n) {
+			if (first == last)
+				return;
+			transfer(position, first, last);
+			if (&x != this) {
+				len += n;
+				x.len -= n;
+			}
 		}
 		void merge(list<T, Alloc>& x); // xϲ*thisϣlistݱȾ
 		void reverse(); // *this
+		void swap(list& x) {
+			link_type tmp = node;
+			node = x.node;
+			x.node = tmp;
+			size_type tmp_len = len;
+			len = x.len;
+			x.len = tmp_len;
+		}
 		void sort(); // listʹstlsort()ֻʹԼĳԱ
+		// threads߳ԪصıȽϲ׳쳣
+		void sort(size_type threads);
+
+	protected:
+		// ڵ϶ʱʽռڵָ ->  -> ´
+		// ޷ûʱfalseֲ
+		bool relink_sort(size_type n, size_type threads);
 	};
 
 	template<class T, class Alloc>
@@ -193,36 +369,65 @@ namespace ChuSTL {
 		}
 		node->next = node;
 		node->prev = node;
+		len = 0;
 	}
 	template<class T, class Alloc>
 	void list<T, Alloc>::remove(const T& value) {
-		iterator first = begin();
-		iterator last = end();
-		while (first != last) {
-			iterator next = first;
-			next++;
-			if (*first == value)
-				erase(first);
-			first = next;
+		remove_if(__list_equal_value<T>(value));
+	}
+	template<class T, class Alloc>
+	template<class Predicate>
+	void list<T, Alloc>::remove_if(Predicate pred) {
+		link_type garbage = 0;	// ժµĽڵ㣬next
+		link_type* tail = &garbage;
+		try {
+			for (link_type cur = link_type(node->next); cur != node; ) {
+				link_type next = link_type(cur->next);
+				if (pred(cur->data))
+					unlink_to_chain(cur, tail);
+				cur = next;
+			}
+		}
+		catch (...) {
+			*tail = 0;
+			destroy_chain(garbage);
+			throw;
 		}
+		*tail = 0;
+		destroy_chain(garbage);
 	}
 	template<class T, class Alloc>
 	void list<T, Alloc>::unique() {
-		iterator first = begin();
-		iterator last = end();
-		if (first == last)
-			return;
-		iterator next = first;
-		while (++next != last) {
-			if (*first == *next)
-				erase(next);
-			else
-				first = next;
-			next = first;
+		unique(std::equal_to<T>());
+	}
+	template<class T, class Alloc>
+	template<class BinaryPredicate>
+	void list<T, Alloc>::unique(BinaryPredicate binary_pred) {
+		link_type garbage = 0;
+		link_type* tail = &garbage;
+		try {
+			link_type first = link_type(node->next);
+			for (link_type cur = link_type(first->next); first != node && cur != node; ) {
+				link_type next = link_type(cur->next);
+				if (binary_pred(first->data, cur->data))
+					unlink_to_chain(cur, tail);
+				else
+					first = cur;
+				cur = next;
+			}
+		}
+		catch (...) {
+			*tail = 0;
+			destroy_chain(garbage);
+			throw;
 		}
+		*tail = 0;
+		destroy_chain(garbage);
 	}
 	template<class T, class Alloc>
 	void list<T, Alloc>::merge(list<T, Alloc>& x) {
+		if (this == &x)
+			return;
 		iterator first1 = begin();
 		iterator last1 = end();
 		iterator first2 = x.begin();
@@ -230,8 +435,9 @@ namespace ChuSTL {
 
 		while (first1 != last1 && first2 != last2) {
 			if (*first2 < *first1) {
-				iterator next = firsr2;
+				iterator next = first2;
 				transfer(first1, first2, ++next);
+				first2 = next;
 			}
 			else {
 				++first1;
@@ -239,6 +445,8 @@ namespace ChuSTL {
 		}
 		if (first2 != last2)
 			transfer(last1, first2, last2);
+		len += x.len;
+		x.len = 0;
 	}
 	template<class T, class Alloc>
 	void list<T, Alloc>::reverse() {
@@ -254,8 +462,17 @@ namespace ChuSTL {
 	}
 	template<class T, class Alloc>
 	void list<T, Alloc>::sort() {
+		sort(1);
+	}
+	template<class T, class Alloc>
+	void list<T, Alloc>::sort(size_type threads) {
 		if (node->next == node || link_type(node->next)->next == node)
 			return;
+		size_type n = size();
+		if (n >= __list_sort_relink_threshold && relink_sort(n, threads))
+			return;
+
+		// ڵʱ鲢ռ
 		list<T, Alloc> carry;
 		list<T, Alloc> counter[64];
 		int fill = 0;
@@ -275,7 +492,44 @@ namespace ChuSTL {
 			counter[i].merge(counter[i - 1]);
 		swap(counter[fill - 1]);
 	}
+	template<class T, class Alloc>
+	bool list<T, Alloc>::relink_sort(size_type n, size_type threads) {
+		typedef simple_alloc<link_type, Alloc> link_allocator;
+		// ǰnλôŽڵָ룬nλΪ鲢
+		link_type* links;
+		try {
+			links = link_allocator::allocate(2 * n);
+		}
+		catch (...) {
+			return false;
+		}
+
+		link_type* last = links;
+		for (link_type cur = link_type(node->next); cur != node; cur = link_type(cur->next))
+			*last++ = cur;
+		try {
+			__list_parallel_sort_links(links, last, links + n, threads);
+		}
+		catch (...) {
+			// Ƚ׳쳣ʱڵδĶԭд
+			link_allocator::deallocate(links, 2 * n);
+			throw;
+		}
+
+		// Ĵһؽprev/next
+		link_type prev = node;
+		for (link_type* i = links; i != last; ++i) {
+			prev->next = *i;
+			(*i)->prev = prev;
+			prev = *i;
+		}
+		prev->next = node;
+		node->prev = prev;
+
+		link_allocator::deallocate(links, 2 * n);
+		return true;
+	}
 
 }
 
-#endif // !_CHUSTL_LIST_H
+#endif // !_CHUSTL_LIST_H
\ No newline at end of file
@@ -0,0 +1,286 @@
+#pragma once
+
+#ifndef _CHUSTL_MAPPEDVECTOR_H_
+#define _CHUSTL_MAPPEDVECTOR_H_
+
+#include <cstddef>
+#include <cstring>		// for memcpy, memcmp
+#include <new>			// for bad_alloc
+#include <stdexcept>	// for logic_error
+#include <type_traits>	// for is_trivially_copyable
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Vector.h"		// for vector_growth_x2
+
+namespace ChuSTL {
+
+	/*
+	* mapped_vector: ڴӳļΪ洢ռvectorԪرtrivially copyable
+	* ļΪ64ֽڵļͷ(magicԪشСԪظ)ŵԪ
+	* ļֱʹеݣӳͬһļʱpage cache
+	* ÿռ䲻ʱGrowthPolicyftruncateļmremap
+	* Ԫظsync()close()ʱдļͷ
+	* ֻģʽ˽ӳ򿪣ɷconstӿ޸ԪֻĶ̵ĸдļ
+	* ıԪظĲֻģʽ׳logic_error
+	*/
+	template<class T, class GrowthPolicy = vector_growth_x2>
+	class mapped_vector {
+		static_assert(std::is_trivially_copyable<T>::value, "mapped_vector requires a trivially copyable T");
+
+	public:
+		typedef T								value_type;
+		typedef T*								pointer;
+		typedef const T*						const_pointer;
+		typedef T*								iterator;
+		typedef const T*						const_iterator;
+		typedef T&								reference;
+		typedef const T&						const_reference;
+		typedef size_t							size_type;
+		typedef ptrdiff_t						difference_type;
+
+		enum open_mode {
+			read_only,		// ļڣԪص޸ĲдļܸıԪظ
+			read_write,		// ļʱʱԭ
+			overwrite		// ļʱʱ
+		};
+
+	protected:
+		struct header {
+			char magic[8];
+			size_t elem_size;
+			size_t size;
+		};
+		enum { header_bytes = 64 };
+
+		int fd;
+		char* base;				// ӳʼַļͷ
+		size_type mapped_bytes;	// ӳ(༴ļ)ĳ
+		bool writable;
+		iterator start;
+		iterator finish;
+		iterator end_of_storage;
+
+		static const char* magic() { return "CHUMVEC"; }
+
+		header* get_header() const { return reinterpret_cast<header*>(base); }
+
+		// bytesΪ()ӳļָ
+		bool map(size_type bytes);
+		// ļʹnԪ
+		void grow(size_type n);
+		void check_writable() const {
+			if (!writable)
+				throw std::logic_error("mapped_vector: modifying a read-only mapping");
+		}
+
+	private:
+		mapped_vector(const mapped_vector&);
+		mapped_vector& operator=(const mapped_vector&);
+
+	public:
+		mapped_vector()
+			: fd(-1), base(0), mapped_bytes(0), writable(false), start(0), finish(0), end_of_storage(0) {}
+		explicit mapped_vector(const char* path, open_mode mode = read_write)
+			: fd(-1), base(0), mapped_bytes(0), writable(false), start(0), finish(0), end_of_storage(0) {
+			open(path, mode);
+		}
+		~mapped_vector() { close(); }
+
+		// 򿪲ӳļ(ȹرѴ򿪵ļ)ʧʱfalseδ״̬
+		bool open(const char* path, open_mode mode = read_write);
+		// дԪظõÿռ䲢ӳ䣻۳ɰܶδ״̬üرļʧʱfalse
+		bool close();
+		// дԪظӳˢļ
+		bool sync();
+
+		bool is_open() const { return fd != -1; }
+		bool is_read_only() const { return !writable; }
+
+		iterator begin() { return start; }
+		const_iterator begin() const { return start; }
+		const_iterator cbegin() const { return start; }
+		iterator end() { return finish; }
+		const_iterator end() const { return finish; }
+		const_iterator cend() const { return finish; }
+
+		size_type size() const { return size_type(finish - start); }
+		size_type capacity() const { return size_type(end_of_storage - start); }
+		bool empty() const { return start == finish; }
+		reference operator[](size_type n) { return *(start + n); }
+		const_reference operator[](size_type n) const { return *(start + n); }
+		reference front() { return *start; }
+		const_reference front() const { return *start; }
+		reference back() { return *(finish - 1); }
+		const_reference back() const { return *(finish - 1); }
+		pointer data() { return start; }
+		const_pointer data() const { return start; }
+
+		// ޸ĲڿдģʽЧ׳logic_error
+		// xеԪأʱӳƶȸһ
+		void push_back(const T& x) {
+			check_writable();
+			if (finish == end_of_storage) {
+				T x_copy = x;
+				grow(size() + 1);
+				memcpy(finish, &x_copy, sizeof(T));
+			}
+			else
+				memcpy(finish, &x, sizeof(T));
+			++finish;
+		}
+		void pop_back() {
+			check_writable();
+			--finish;
+		}
+		void clear() {
+			check_writable();
+			finish = start;
+		}
+		void reserve(size_type n) {
+			check_writable();
+			if (capacity() < n)
+				grow(n);
+		}
+		void resize(size_type new_size, const T& x) {
+			check_writable();
+			T x_copy = x;
+			reserve(new_size);
+			for (; finish < start + new_size; ++finish)
+				memcpy(finish, &x_copy, sizeof(T));
+			finish = start + new_size;
+		}
+		void resize(size_type new_size) {
+			resize(new_size, T());
+		}
+	};
+
+	template<class T, class GrowthPolicy>
+	bool mapped_vector<T, GrowthPolicy>::map(size_type bytes)
+	{
+		void* p;
+		// ֻģʽдʱƵ˽ӳ䣬ɷconstӿдԪزδ
+		int flags = writable ? MAP_SHARED : MAP_PRIVATE;
+		if (base == 0)
+			p = mmap(0, bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+		else {
+#ifdef __linux__
+			p = mremap(base, mapped_bytes, bytes, MREMAP_MAYMOVE);
+#else
+			// Ƚӳ䣬ɹŽӳ䣬ʧʱԭӳȻЧ
+			p = mmap(0, bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+			if (p != MAP_FAILED)
+				munmap(base, mapped_bytes);
+#endif
+		}
+		if (p == MAP_FAILED)
+			return false;
+
+		size_type n = finish - start;
+		base = static_cast<char*>(p);
+		mapped_bytes = bytes;
+		start = reinterpret_cast<iterator>(base + header_bytes);
+		finish = start + n;
+		end_of_storage = start + (bytes - header_bytes) / sizeof(T);
+		return true;
+	}
+
+	template<class T, class GrowthPolicy>
+	void mapped_vector<T, GrowthPolicy>::grow(size_type n)
+	{
+		size_type len = GrowthPolicy::next_capacity(size(), n, sizeof(T));
+		size_type bytes = header_bytes + len * sizeof(T);
+		// vectorʧʱһ£׳bad_alloc
+		if (ftruncate(fd, off_t(bytes)) != 0 || !map(bytes))
+			throw std::bad_alloc();
+	}
+
+	template<class T, class GrowthPolicy>
+	bool mapped_vector<T, GrowthPolicy>::open(const char* path, open_mode mode)
+	{
+		close();
+
+		int flags = mode == read_only ? O_RDONLY : O_RDWR | O_CREAT;
+		if (mode == overwrite)
+			flags |= O_TRUNC;
+		fd = ::open(path, flags, 0644);
+		if (fd == -1)
+			return false;
+		writable = mode != read_only;
+
+		struct stat st;
+		bool ok = fstat(fd, &st) == 0;
+		size_type bytes = ok ? size_type(st.st_size) : 0;
+		if (ok && bytes == 0 && writable) {
+			// ļдļͷ
+			bytes = header_bytes;
+			ok = ftruncate(fd, off_t(bytes)) == 0 && map(bytes);
+			if (ok) {
+				memcpy(get_header()->magic, magic(), sizeof(get_header()->magic));
+				get_header()->elem_size = sizeof(T);
+				get_header()->size = 0;
+			}
+		}
+		else if (ok && bytes >= size_type(header_bytes)) {
+			ok = map(bytes);
+			// ļͷԪشСԪظóļ
+			ok = ok && memcmp(get_header()->magic, magic(), sizeof(get_header()->magic)) == 0
+				&& get_header()->elem_size == sizeof(T)
+				&& get_header()->size <= capacity();
+			if (ok)
+				finish = start + get_header()->size;
+		}
+		else {
+			ok = false;
+		}
+
+		if (!ok) {
+			if (base)
+				munmap(base, mapped_bytes);
+			::close(fd);
+			fd = -1;
+			base = 0;
+			mapped_bytes = 0;
+			writable = false;
+			start = finish = end_of_storage = 0;
+		}
+		return ok;
+	}
+
+	template<class T, class GrowthPolicy>
+	bool mapped_vector<T, GrowthPolicy>::sync()
+	{
+		if (!is_open() || !writable)
+			return is_open();
+		get_header()->size = size();
+		return msync(base, mapped_bytes, MS_SYNC) == 0;
+	}
+
+	template<class T, class GrowthPolicy>
+	bool mapped_vector<T, GrowthPolicy>::close()
+	{
+		if (!is_open())
+			return true;
+		size_type used = header_bytes + size() * sizeof(T);
+		if (writable)
+			get_header()->size = size();
+		bool ok = munmap(base, mapped_bytes) == 0;
+		// õÿռ䣬ٴδʱΪԪظ
+		if (writable && used < mapped_bytes)
+			ok = ftruncate(fd, off_t(used)) == 0 && ok;
+		ok = ::close(fd) == 0 && ok;
+
+		fd = -1;
+		base = 0;
+		mapped_bytes = 0;
+		writable = false;
+		start = finish = end_of_storage = 0;
+		return ok;
+	}
+
+}
+
+#endif // !_CHUSTL_MAPPEDVECTOR_H_
\ No newline at end of file
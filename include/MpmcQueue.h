@@ -0,0 +1,238 @@
+#pragma once
+
+#ifndef _CHUSTL_MPMCQUEUE_H_
+#define _CHUSTL_MPMCQUEUE_H_
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "SpscQueue.h"	// for __cache_line_size
+
+namespace ChuSTL {
+
+	// ÿλһţposʱдposռãpos + 1ʱɶȡposȡ
+	template<class T>
+	struct __mpmc_queue_cell {
+		std::atomic<size_t> sequence;
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T* value() { return reinterpret_cast<T*>(storage); }
+	};
+
+	/*
+	* mpmc_queue: ߶ߵн
+	* ߸CASƽenqueue_pos/dequeue_posռòλԲλŽԪأ
+	* ͬλϵĲţҲûȫֵ
+	* try_push/try_popӲpush/popԣԲɹߣ
+	* ֻдʱԷŻѣ޾ʱ
+	* ΪСڹ2ݣλڹʱһ
+	* Ԫصĸƹ켰ֵ׳쳣λһռñ޷
+	*/
+	template<class T, class Alloc> // class Alloc = alloc
+	class mpmc_queue {
+	public:
+		typedef T						value_type;
+		typedef T*						pointer;
+		typedef T&						reference;
+		typedef const T&				const_reference;
+		typedef size_t					size_type;
+
+	protected:
+		typedef __mpmc_queue_cell<T> cell;
+		typedef simple_alloc<cell, Alloc> cell_allocator;
+
+		enum { spin_limit = 64 };
+
+		// ֻ߳
+		cell* cells;
+		size_type cap;
+		// ֮侺
+		alignas(__cache_line_size) std::atomic<size_type> enqueue_pos;
+		// ֮侺
+		alignas(__cache_line_size) std::atomic<size_type> dequeue_pos;
+		// 뻽
+		alignas(__cache_line_size) std::atomic<int> push_waiters;
+		std::atomic<int> pop_waiters;
+		std::mutex park_mutex;
+		std::condition_variable not_full;
+		std::condition_variable not_empty;
+
+		cell* cell_at(size_type pos) const { return cells + (pos & (cap - 1)); }
+
+		// ռһд/ɶĲλʧʱ0ɹʱposΪռλ
+		cell* claim_push(size_type& pos);
+		cell* claim_pop(size_type& pos);
+
+		// ѶԷķȡ·park_mutexʱʹ
+		bool push_no_wake(const value_type& x) {
+			size_type pos;
+			cell* c = claim_push(pos);
+			if (!c)
+				return false;
+			construct(c->value(), x);
+			c->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+		bool pop_no_wake(value_type& result) {
+			size_type pos;
+			cell* c = claim_pop(pos);
+			if (!c)
+				return false;
+			result = *c->value();
+			destroy(c->value());
+			c->sequence.store(pos + cap, std::memory_order_release);
+			return true;
+		}
+
+		// óһλԪ֮áseq_cstϣ֤߼һܿν
+		void wake(std::atomic<int>& waiters, std::condition_variable& cond) {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (waiters.load(std::memory_order_relaxed) != 0) {
+				std::lock_guard<std::mutex> lock(park_mutex);
+				cond.notify_one();
+			}
+		}
+
+	private:
+		mpmc_queue(const mpmc_queue&);
+		mpmc_queue& operator=(const mpmc_queue&);
+
+	public:
+		explicit mpmc_queue(size_type n);
+		~mpmc_queue();
+
+		size_type capacity() const { return cap; }
+		// ڲʱֻǽֵ
+		size_type size() const {
+			size_type head = dequeue_pos.load(std::memory_order_acquire);
+			size_type tail = enqueue_pos.load(std::memory_order_acquire);
+			return tail > head ? tail - head : 0;
+		}
+		bool empty() const { return size() == 0; }
+
+		// ʱfalse
+		bool try_push(const value_type& x) {
+			if (!push_no_wake(x))
+				return false;
+			wake(pop_waiters, not_empty);
+			return true;
+		}
+		// Ϊʱfalseȡͷresult
+		bool try_pop(value_type& result) {
+			if (!pop_no_wake(result))
+				return false;
+			wake(push_waiters, not_full);
+			return true;
+		}
+		// ʱȴڳλ
+		void push(const value_type& x);
+		// Ϊʱȴ߷Ԫ
+		void pop(value_type& result);
+	};
+
+	template<class T, class Alloc>
+	mpmc_queue<T, Alloc>::mpmc_queue(size_type n)
+		: cells(0), cap(1), enqueue_pos(0), dequeue_pos(0), push_waiters(0), pop_waiters(0)
+	{
+		while (cap < n)
+			cap <<= 1;
+		cells = cell_allocator::allocate(cap);
+		for (size_type i = 0; i != cap; ++i)
+			new (&cells[i].sequence) std::atomic<size_type>(i);
+	}
+
+	template<class T, class Alloc>
+	mpmc_queue<T, Alloc>::~mpmc_queue()
+	{
+		size_type tail = enqueue_pos.load(std::memory_order_relaxed);
+		for (size_type pos = dequeue_pos.load(std::memory_order_relaxed); pos != tail; ++pos)
+			destroy(cell_at(pos)->value());
+		cell_allocator::deallocate(cells, cap);
+	}
+
+	template<class T, class Alloc>
+	typename mpmc_queue<T, Alloc>::cell* mpmc_queue<T, Alloc>::claim_push(size_type& pos)
+	{
+		pos = enqueue_pos.load(std::memory_order_relaxed);
+		for (;;) {
+			cell* c = cell_at(pos);
+			ptrdiff_t dif = ptrdiff_t(c->sequence.load(std::memory_order_acquire) - pos);
+			if (dif == 0) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					return c;
+			}
+			else if (dif < 0) {
+				// òλһֵԪδȡߣ
+				return 0;
+			}
+			else {
+				// ѱռ
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<class T, class Alloc>
+	typename mpmc_queue<T, Alloc>::cell* mpmc_queue<T, Alloc>::claim_pop(size_type& pos)
+	{
+		pos = dequeue_pos.load(std::memory_order_relaxed);
+		for (;;) {
+			cell* c = cell_at(pos);
+			ptrdiff_t dif = ptrdiff_t(c->sequence.load(std::memory_order_acquire) - (pos + 1));
+			if (dif == 0) {
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					return c;
+			}
+			else if (dif < 0) {
+				// òλԪδд룬Ϊ
+				return 0;
+			}
+			else {
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<class T, class Alloc>
+	void mpmc_queue<T, Alloc>::push(const value_type& x)
+	{
+		for (int i = 0; i != spin_limit; ++i) {
+			if (try_push(x))
+				return;
+			std::this_thread::yield();
+		}
+		std::unique_lock<std::mutex> lock(park_mutex);
+		push_waiters.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		while (!push_no_wake(x))
+			not_full.wait(lock);
+		push_waiters.fetch_sub(1);
+		lock.unlock();
+		wake(pop_waiters, not_empty);
+	}
+
+	template<class T, class Alloc>
+	void mpmc_queue<T, Alloc>::pop(value_type& result)
+	{
+		for (int i = 0; i != spin_limit; ++i) {
+			if (try_pop(result))
+				return;
+			std::this_thread::yield();
+		}
+		std::unique_lock<std::mutex> lock(park_mutex);
+		pop_waiters.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		while (!pop_no_wake(result))
+			not_empty.wait(lock);
+		pop_waiters.fetch_sub(1);
+		lock.unlock();
+		wake(push_waiters, not_full);
+	}
+
+}
+
+#endif // !_CHUSTL_MPMCQUEUE_H_
\ No newline at end of file
@@ -22,12 +22,16 @@ namespace ChuSTL {
 		Container c;
 
 	public:
+		queue() : c() {}
+		// xΪײĳʼݣúring_buffer
+		explicit queue(const Container& x) : c(x) {}
+
 		bool empty() const { return c.empty(); }
 		size_type size() const { return c.size(); }
 		reference front() { return c.front(); }
 		const_reference front() const { return c.front(); }
 		reference back() { return c.back(); }
-		const_reference frbackont() const { return c.back(); }
+		const_reference back() const { return c.back(); }
 		void push(const value_type& x) { c.push_back(x); }
 		void pop() { c.pop_front(); }
 
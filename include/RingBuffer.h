@@ -0,0 +1,279 @@
+#pragma once
+
+#ifndef _CHUSTL_RINGBUFFER_H_
+#define _CHUSTL_RINGBUFFER_H_
+
+#include <utility>		// for pair
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Iterator.h"
+#include "Span.h"
+#include "Uninitialized.h"
+
+namespace ChuSTL {
+
+	// (, , ߼±)ʾλã߼±굥ȡģֻ
+	template<class T, class Ref, class Ptr>
+	struct __ring_buffer_iterator {
+		typedef T												value_type;
+		typedef Ptr												pointer;
+		typedef Ref												reference;
+		typedef size_t											size_type;
+		typedef ptrdiff_t										difference_type;
+
+		typedef random_access_iterator_tag						iterator_category;
+		typedef __ring_buffer_iterator							self;
+		typedef __ring_buffer_iterator<T, T&, T*>				iterator;
+
+		T* buf;
+		size_type mask;
+		size_type index;
+
+		__ring_buffer_iterator() : buf(0), mask(0), index(0) {}
+		__ring_buffer_iterator(T* b, size_type m, size_type i) : buf(b), mask(m), index(i) {}
+		__ring_buffer_iterator(const iterator& x) : buf(x.buf), mask(x.mask), index(x.index) {}
+
+		reference operator*() const { return buf[index & mask]; }
+		pointer operator->() const { return &(operator*()); }
+		self& operator++() {
+			++index;
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++index;
+			return tmp;
+		}
+		self& operator--() {
+			--index;
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			--index;
+			return tmp;
+		}
+		self& operator+=(difference_type n) {
+			index += n;
+			return *this;
+		}
+		self& operator-=(difference_type n) {
+			index -= n;
+			return *this;
+		}
+		self operator+(difference_type n) const { return self(buf, mask, index + n); }
+		self operator-(difference_type n) const { return self(buf, mask, index - n); }
+		// ߼±ƺֵȻȷ
+		difference_type operator-(const self& x) const { return difference_type(index - x.index); }
+		reference operator[](difference_type n) const { return buf[(index + n) & mask]; }
+		bool operator==(const self& x) const { return index == x.index; }
+		bool operator!=(const self& x) const { return index != x.index; }
+		bool operator<(const self& x) const { return difference_type(index - x.index) < 0; }
+	};
+
+	/*
+	* ring_buffer: һռѭԪص˫
+	* 2ݣheadtailΪ߼±꣬Ԫظtail - headλΪ± & ( - 1)
+	* ʱģʽ¶һɵԪأӱ㹻˺ÿռ
+	* as_spans()ԪذΪռ䣬ֱӽwritev
+	* ṩqueue/stackȫΪǵContainer
+	*/
+	template<class T, class Alloc> // class Alloc = alloc
+	class ring_buffer {
+	public:
+		typedef T														value_type;
+		typedef T*														pointer;
+		typedef T&														reference;
+		typedef const T&												const_reference;
+		typedef size_t													size_type;
+		typedef ptrdiff_t												difference_type;
+		typedef __ring_buffer_iterator<T, T&, T*>						iterator;
+		typedef __ring_buffer_iterator<T, const T&, const T*>			const_iterator;
+		typedef std::pair<span<T>, span<T> >							spans;
+		typedef std::pair<span<const T>, span<const T> >				const_spans;
+
+	protected:
+		typedef simple_alloc<value_type, Alloc> data_allocator;
+
+		pointer buf;
+		size_type cap;			// 2ݣδÿռʱΪ0
+		size_type head;			// һԪص߼±
+		size_type tail;			// һԪ֮߼±
+		bool overwrite;
+
+		size_type mask() const { return cap - 1; }
+		pointer slot(size_type i) const { return buf + (i & mask()); }
+
+		static size_type round_up(size_type n) {
+			size_type c = 1;
+			while (c < n)
+				c <<= 1;
+			return c;
+		}
+		// Ϊn¿ռ䣬ԪƵͷ
+		void reallocate(size_type n);
+		// ҲܸʱҪ
+		bool need_grow() const { return tail - head == cap && !(overwrite && cap != 0); }
+		void grow() { reallocate(cap ? cap * 2 : 1); }
+
+	public:
+		ring_buffer() : buf(0), cap(0), head(0), tail(0), overwrite(false) {}
+		// ΪСn2ݣoverwrite_oldestΪʱǸɵԪ
+		explicit ring_buffer(size_type n, bool overwrite_oldest = false)
+			: buf(0), cap(0), head(0), tail(0), overwrite(overwrite_oldest) {
+			if (n)
+				reallocate(round_up(n));
+		}
+		ring_buffer(const ring_buffer& x);
+		ring_buffer& operator=(const ring_buffer& x) {
+			ring_buffer tmp(x);
+			swap(tmp);
+			return *this;
+		}
+		~ring_buffer() {
+			clear();
+			data_allocator::deallocate(buf, cap);
+		}
+
+		iterator begin() { return iterator(buf, mask(), head); }
+		const_iterator begin() const { return const_iterator(buf, mask(), head); }
+		iterator end() { return iterator(buf, mask(), tail); }
+		const_iterator end() const { return const_iterator(buf, mask(), tail); }
+
+		size_type size() const { return tail - head; }
+		size_type capacity() const { return cap; }
+		size_type max_size() const { return size_type(-1) / sizeof(T); }
+		bool empty() const { return head == tail; }
+		bool full() const { return size() == cap; }
+		bool overwrites_oldest() const { return overwrite; }
+		void set_overwrite_oldest(bool x) { overwrite = x; }
+
+		reference operator[](size_type n) { return *slot(head + n); }
+		const_reference operator[](size_type n) const { return *slot(head + n); }
+		reference front() { return *slot(head); }
+		const_reference front() const { return *slot(head); }
+		reference back() { return *slot(tail - 1); }
+		const_reference back() const { return *slot(tail - 1); }
+
+		void push_back(const value_type& x) {
+			if (need_grow()) {
+				// xܾǱеԪ
+				value_type x_copy = x;
+				grow();
+				construct(slot(tail), x_copy);
+				++tail;
+			}
+			else if (!full()) {
+				construct(slot(tail), x);
+				++tail;
+			}
+			else {
+				// ǰ˵Ԫأһ
+				*slot(head) = x;
+				++head;
+				++tail;
+			}
+		}
+		void push_front(const value_type& x) {
+			if (need_grow()) {
+				value_type x_copy = x;
+				grow();
+				construct(slot(head - 1), x_copy);
+				--head;
+			}
+			else if (!full()) {
+				construct(slot(head - 1), x);
+				--head;
+			}
+			else {
+				// β˵Ԫأǰһ
+				*slot(tail - 1) = x;
+				--head;
+				--tail;
+			}
+		}
+		void pop_front() {
+			destroy(slot(head));
+			++head;
+		}
+		void pop_back() {
+			--tail;
+			destroy(slot(tail));
+		}
+		void clear() {
+			while (head != tail)
+				pop_back();
+			head = tail = 0;
+		}
+		// ֤Сn
+		void reserve(size_type n) {
+			if (n > cap)
+				reallocate(round_up(n));
+		}
+
+		// еռ䣬ڶֻԪؿβʱǿ
+		spans as_spans() {
+			pointer first = slot(head);
+			size_type n = size();
+			size_type until_end = cap - (head & mask());
+			if (n <= until_end)
+				return spans(span<T>(first, n), span<T>());
+			return spans(span<T>(first, until_end), span<T>(buf, n - until_end));
+		}
+		const_spans as_spans() const {
+			spans s = const_cast<ring_buffer*>(this)->as_spans();
+			return const_spans(span<const T>(s.first.data(), s.first.size()),
+				span<const T>(s.second.data(), s.second.size()));
+		}
+
+		void swap(ring_buffer& x) {
+			pointer tmp_buf = buf; buf = x.buf; x.buf = tmp_buf;
+			size_type tmp = cap; cap = x.cap; x.cap = tmp;
+			tmp = head; head = x.head; x.head = tmp;
+			tmp = tail; tail = x.tail; x.tail = tmp;
+			bool tmp_overwrite = overwrite; overwrite = x.overwrite; x.overwrite = tmp_overwrite;
+		}
+	};
+
+	template<class T, class Alloc>
+	ring_buffer<T, Alloc>::ring_buffer(const ring_buffer& x)
+		: buf(0), cap(0), head(0), tail(0), overwrite(x.overwrite)
+	{
+		if (x.cap == 0)
+			return;
+		buf = data_allocator::allocate(x.cap);
+		cap = x.cap;
+		try {
+			uninitialized_copy(x.begin(), x.end(), buf);
+		}
+		catch (...) {
+			data_allocator::deallocate(buf, cap);
+			throw;
+		}
+		tail = x.size();
+	}
+
+	template<class T, class Alloc>
+	void ring_buffer<T, Alloc>::reallocate(size_type n)
+	{
+		pointer new_buf = data_allocator::allocate(n);
+		size_type len = size();
+		try {
+			uninitialized_copy(begin(), end(), new_buf);
+		}
+		catch (...) {
+			data_allocator::deallocate(new_buf, n);
+			throw;
+		}
+		clear();
+		data_allocator::deallocate(buf, cap);
+		buf = new_buf;
+		cap = n;
+		head = 0;
+		tail = len;
+	}
+
+}
+
+#endif // !_CHUSTL_RINGBUFFER_H_
\ No newline at end of file
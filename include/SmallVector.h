@@ -0,0 +1,349 @@
+#pragma once
+
+#ifndef _CHUSTL_SMALLVECTOR_H_
+#define _CHUSTL_SMALLVECTOR_H_
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Iterator.h"
+#include "Uninitialized.h"
+#include "Vector.h"
+
+namespace ChuSTL {
+
+	/*
+	* small_vector: ǰNԪֱӴڶڲĻУκ
+	* ԪظNʱ""AllocõĿռ䣬˺vector::insert_aux/insert
+	* start/finish/end_of_storageȻvectorָ룬ָֻڲ
+	* ʱͬGrowthPolicy
+	* ˽м̳vectorvector&reserveȲڲõĿռͷţ˲ṩת
+	* vector<bool>λػûָ룬ʲ֧TΪbool
+	*/
+	template<class T, size_t N, class Alloc, class GrowthPolicy = vector_growth_x2> // class Alloc = alloc
+	class small_vector : private vector<T, Alloc, GrowthPolicy> {
+		static_assert(!std::is_same<T, bool>::value, "small_vector<bool> is not supported, vector<bool> is a bit vector");
+
+	protected:
+		typedef vector<T, Alloc, GrowthPolicy>			base;
+
+	public:
+		typedef typename base::value_type				value_type;
+		typedef typename base::pointer					pointer;
+		typedef typename base::iterator					iterator;
+		typedef typename base::const_iterator			const_iterator;
+		typedef typename base::reference				reference;
+		typedef typename base::const_reference			const_reference;
+		typedef typename base::size_type				size_type;
+		typedef typename base::difference_type			difference_type;
+
+	protected:
+		typedef typename base::data_allocator			data_allocator;
+
+		// ڲNΪ0ʱԱһԪشС㳤
+		alignas(T) unsigned char buffer[sizeof(T) * (N != 0 ? N : 1)];
+
+		iterator inline_begin() { return reinterpret_cast<iterator>(buffer); }
+		const_iterator inline_begin() const { return reinterpret_cast<const_iterator>(buffer); }
+
+		// ָָڲ
+		void inline_initialize() {
+			this->start = inline_begin();
+			this->finish = this->start;
+			this->end_of_storage = this->start + N;
+		}
+
+		// ԪشڲᵽõlenԪؿռϣ˺vectorӹ
+		void grow_out_of_inline(size_type len);
+		// ԪذڲͷõĿռ䣬size()ôN
+		void move_into_inline();
+		// ͬʱposition֮ǰ[first, last)¿ռƴãڲеԪ
+		template<class ForwardIterator>
+		void grow_out_of_inline(iterator position, ForwardIterator first, ForwardIterator last, size_type n);
+
+		// [first, last)ǷָеԪ
+		bool in_storage(const_iterator first, const_iterator last) const {
+			return first != last && this->start <= first && first < this->finish;
+		}
+		bool in_storage(iterator first, iterator last) const {
+			return in_storage(const_iterator(first), const_iterator(last));
+		}
+		template<class ForwardIterator>
+		bool in_storage(ForwardIterator, ForwardIterator) const { return false; }
+
+		// ֤nԪأڲʱʱ
+		void ensure_heap_capacity(size_type n) {
+			if (is_inline()) {
+				if (n > N)
+					grow_out_of_inline(this->next_capacity(n));
+			}
+			else if (n > this->capacity()) {
+				base::reserve(n);
+			}
+		}
+
+		// Ҫposition֮ǰnԪأҪʱpositionӦĵ
+		iterator make_room(iterator position, size_type n) {
+			if (is_inline() && this->size() + n > N) {
+				const size_type index = position - this->start;
+				grow_out_of_inline(this->next_capacity(this->size() + n));
+				position = this->start + index;
+			}
+			return position;
+		}
+
+		template<class InputIterator>
+		void assign_aux(InputIterator first, InputIterator last, std::false_type) {
+			range_assign(first, last, iterator_category(first));
+		}
+		template<class Integer>
+		void assign_aux(Integer n, Integer value, std::true_type) {
+			assign(size_type(n), value_type(value));
+		}
+		template<class InputIterator>
+		void range_assign(InputIterator first, InputIterator last, input_iterator_tag) {
+			this->clear();
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+		template<class ForwardIterator>
+		void range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+			ensure_heap_capacity(distance(first, last));
+			base::assign(first, last);
+		}
+
+		template<class InputIterator>
+		void insert_dispatch(iterator position, InputIterator first, InputIterator last, std::false_type) {
+			range_insert(position, first, last, iterator_category(first));
+		}
+		template<class Integer>
+		void insert_dispatch(iterator position, Integer n, Integer value, std::true_type) {
+			position = make_room(position, size_type(n));
+			base::insert(position, size_type(n), value_type(value));
+		}
+		template<class InputIterator>
+		void range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+			for (; first != last; ++first) {
+				position = insert(position, *first);
+				++position;
+			}
+		}
+		// [first, last)ָʱֱ¿ռƴӣʱȸһݣⱻᶯԪظ
+		template<class ForwardIterator>
+		void range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+			size_type n = distance(first, last);
+			if (is_inline() && this->size() + n > N) {
+				grow_out_of_inline(position, first, last, n);
+			}
+			else if (in_storage(first, last)) {
+				small_vector tmp(first, last);
+				base::insert(position, tmp.begin(), tmp.end());
+			}
+			else {
+				base::insert(position, first, last);
+			}
+		}
+
+	public:
+		using base::begin;
+		using base::cbegin;
+		using base::end;
+		using base::cend;
+		using base::size;
+		using base::capacity;
+		using base::empty;
+		using base::operator[];
+		using base::front;
+		using base::back;
+		using base::data;
+		using base::pop_back;
+		using base::erase;
+		using base::clear;
+
+		bool is_inline() const { return this->start == inline_begin(); }
+
+		small_vector() { inline_initialize(); }
+		small_vector(size_type n, const T& value) { fill_initialize(n, value); }
+		small_vector(int n, const T& value) { fill_initialize(n, value); }
+		small_vector(long n, const T& value) { fill_initialize(n, value); }
+		explicit small_vector(size_type n) { fill_initialize(n, T()); }
+		template<class InputIterator>
+		small_vector(InputIterator first, InputIterator last) {
+			inline_initialize();
+			insert(this->end(), first, last);
+		}
+		small_vector(const small_vector& x) {
+			inline_initialize();
+			ensure_heap_capacity(x.size());
+			this->finish = uninitialized_copy(x.cbegin(), x.cend(), this->start);
+		}
+
+		small_vector& operator=(const small_vector& x) {
+			if (this != &x) {
+				this->clear();
+				ensure_heap_capacity(x.size());
+				this->finish = uninitialized_copy(x.cbegin(), x.cend(), this->start);
+			}
+			return *this;
+		}
+
+		~small_vector() {
+			// ڲܽvector::deallocateͷţԪزָ
+			if (is_inline()) {
+				destroy(this->start, this->finish);
+				this->start = this->finish = this->end_of_storage = 0;
+			}
+		}
+
+		size_type inline_capacity() const { return N; }
+
+		// »õĲȴڲ
+		// xܾڲеԪأ󼴱ȸһ
+		void push_back(const T& x) {
+			if (this->finish != this->end_of_storage) {
+				construct(this->finish, x);
+				++this->finish;
+			}
+			else if (is_inline()) {
+				T x_copy = x;
+				grow_out_of_inline(this->next_capacity(this->size() + 1));
+				base::push_back(x_copy);
+			}
+			else {
+				base::push_back(x);
+			}
+		}
+
+		iterator insert(iterator position, const T& x) {
+			if (is_inline() && this->size() == N) {
+				T x_copy = x;
+				return base::insert(make_room(position, 1), x_copy);
+			}
+			return base::insert(position, x);
+		}
+		template<class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last) {
+			insert_dispatch(position, first, last, typename std::is_integral<InputIterator>::type());
+		}
+		template<class InputIterator>
+		void append_range(InputIterator first, InputIterator last) {
+			insert(this->end(), first, last);
+		}
+
+		void resize(size_type new_size, const T& x) {
+			if (is_inline() && new_size > N) {
+				T x_copy = x;
+				grow_out_of_inline(this->next_capacity(new_size));
+				base::resize(new_size, x_copy);
+			}
+			else {
+				base::resize(new_size, x);
+			}
+		}
+		void resize(size_type new_size) {
+			resize(new_size, T());
+		}
+
+		void reserve(size_type n) {
+			if (!is_inline())
+				base::reserve(n);
+			else if (n > N)
+				grow_out_of_inline(n);
+		}
+		// Ԫظ䵽NʱڲͷõĿռ
+		void shrink_to_fit() {
+			if (is_inline())
+				return;
+			if (this->size() <= N)
+				move_into_inline();
+			else
+				base::shrink_to_fit();
+		}
+
+		void assign(size_type n, const T& x) {
+			if (is_inline() && n > N) {
+				T x_copy = x;
+				grow_out_of_inline(this->next_capacity(n));
+				base::assign(n, x_copy);
+			}
+			else {
+				base::assign(n, x);
+			}
+		}
+		template<class InputIterator>
+		void assign(InputIterator first, InputIterator last) {
+			assign_aux(first, last, typename std::is_integral<InputIterator>::type());
+		}
+
+	protected:
+		void fill_initialize(size_type n, const T& value) {
+			inline_initialize();
+			ensure_heap_capacity(n);
+			uninitialized_fill_n(this->start, n, value);
+			this->finish = this->start + n;
+		}
+	};
+
+	template<class T, size_t N, class Alloc, class GrowthPolicy>
+	void small_vector<T, N, Alloc, GrowthPolicy>::grow_out_of_inline(size_type len)
+	{
+		iterator new_start = data_allocator::allocate(len);
+		iterator new_finish = new_start;
+		try {
+			new_finish = uninitialized_copy(this->start, this->finish, new_start);
+		}
+		catch (...) {
+			// "commit or rollback" semantics.
+			destroy(new_start, new_finish);
+			data_allocator::deallocate(new_start, len);
+			throw;
+		}
+
+		// ڲеԪأͷ
+		destroy(this->start, this->finish);
+
+		this->start = new_start;
+		this->finish = new_finish;
+		this->end_of_storage = new_start + len;
+	}
+
+	template<class T, size_t N, class Alloc, class GrowthPolicy>
+	template<class ForwardIterator>
+	void small_vector<T, N, Alloc, GrowthPolicy>::grow_out_of_inline(iterator position, ForwardIterator first, ForwardIterator last, size_type n)
+	{
+		const size_type len = this->next_capacity(this->size() + n);
+		iterator new_start = data_allocator::allocate(len);
+		iterator new_finish = new_start;
+		try {
+			new_finish = uninitialized_copy(this->start, position, new_start);
+			new_finish = uninitialized_copy(first, last, new_finish);
+			new_finish = uninitialized_copy(position, this->finish, new_finish);
+		}
+		catch (...) {
+			// "commit or rollback" semantics.
+			destroy(new_start, new_finish);
+			data_allocator::deallocate(new_start, len);
+			throw;
+		}
+
+		destroy(this->start, this->finish);
+
+		this->start = new_start;
+		this->finish = new_finish;
+		this->end_of_storage = new_start + len;
+	}
+
+	template<class T, size_t N, class Alloc, class GrowthPolicy>
+	void small_vector<T, N, Alloc, GrowthPolicy>::move_into_inline()
+	{
+		iterator new_finish = uninitialized_copy(this->start, this->finish, inline_begin());
+		destroy(this->start, this->finish);
+		this->deallocate();
+
+		this->start = inline_begin();
+		this->finish = new_finish;
+		this->end_of_storage = this->start + N;
+	}
+
+}
+
+#endif // !_CHUSTL_SMALLVECTOR_H_
\ No newline at end of file
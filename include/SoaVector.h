@@ -0,0 +1,250 @@
+#pragma once
+
+#ifndef _CHUSTL_SOAVECTOR_H_
+#define _CHUSTL_SOAVECTOR_H_
+
+#include <tuple>
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Span.h"
+#include "Uninitialized.h"
+#include "Vector.h"		// for vector_growth_x2
+
+namespace ChuSTL {
+
+	// C++11ûstd::index_sequenceԴչе±0, 1, ..., N-1
+	template<size_t... I>
+	struct __index_sequence {};
+
+	template<size_t N, size_t... I>
+	struct __make_index_sequence : __make_index_sequence<N - 1, N - 1, I...> {};
+	template<size_t... I>
+	struct __make_index_sequence<0, I...> {
+		typedef __index_sequence<I...> type;
+	};
+
+	template<class Tuple, class Alloc, class GrowthPolicy = vector_growth_x2> // class Alloc = alloc
+	class soa_vector;
+
+	/*
+	* soa_vector: ṹתΪṹ(structure of arrays)
+	* ¼std::tuple<Ts...>ÿֶθԴһռ
+	* жsimple_alloc<Ti, Alloc>ãʼͬһ
+	* ÿһиԵԪشСֱѯʣȡСκһжᳬȡĴС
+	* ֻȡֶεıͨcolumn<I>()ȡøеspanвټдֶ
+	*/
+	template<class... Ts, class Alloc, class GrowthPolicy>
+	class soa_vector<std::tuple<Ts...>, Alloc, GrowthPolicy> {
+	public:
+		typedef std::tuple<Ts...>				value_type;
+		typedef std::tuple<Ts&...>				reference;
+		typedef std::tuple<const Ts&...>		const_reference;
+		typedef size_t							size_type;
+		typedef ptrdiff_t						difference_type;
+
+		template<size_t I>
+		struct column_type {
+			typedef typename std::tuple_element<I, value_type>::type type;
+		};
+
+	protected:
+		typedef std::tuple<Ts*...>				column_pointers;
+		typedef typename __make_index_sequence<sizeof...(Ts)>::type	columns;
+		enum { column_count = sizeof...(Ts) };
+
+		column_pointers cols;	// еͷ
+		size_type len;			// Ԫظ
+		size_type cap;			// ÿһпɵԪظ
+
+		template<size_t I>
+		typename column_type<I>::type* column_data() const { return std::get<I>(cols); }
+
+		// IмаᵽΪn¿ռ䣬¼toxΪʱ¿ռĵlenй*x
+		// κһʧʱɵĸУԭпռ䱣ֲ
+		template<class Tuple, size_t I>
+		void relocate_columns(column_pointers& to, size_type n, const Tuple* x, std::integral_constant<size_t, I>);
+		template<class Tuple>
+		void relocate_columns(column_pointers&, size_type, const Tuple*, std::integral_constant<size_t, column_count>) {}
+
+		// ڵposйIмУֵȡxʧʱѹĸ
+		template<class Tuple, size_t I>
+		void construct_row(size_type pos, const Tuple& x, std::integral_constant<size_t, I>);
+		template<class Tuple>
+		void construct_row(size_type, const Tuple&, std::integral_constant<size_t, column_count>) {}
+
+		template<size_t... I>
+		void destroy_rows(size_type first, size_type last, __index_sequence<I...>) {
+			int expand[] = { 0, (destroy(column_data<I>() + first, column_data<I>() + last), 0)... };
+			(void)expand;
+		}
+		template<size_t... I>
+		void deallocate(__index_sequence<I...>) {
+			int expand[] = { 0, (simple_alloc<Ts, Alloc>::deallocate(column_data<I>(), cap), 0)... };
+			(void)expand;
+		}
+		template<size_t... I>
+		reference row(size_type n, __index_sequence<I...>) const {
+			return reference(column_data<I>()[n]...);
+		}
+
+		// ÿһеԪشСֱѯԣȡС
+		size_type next_capacity(size_type min_size) const {
+			const size_type n[] = { GrowthPolicy::next_capacity(len, min_size, sizeof(Ts))... };
+			size_type r = n[0];
+			for (size_type i = 1; i < size_type(column_count); ++i)
+				if (n[i] < r)
+					r = n[i];
+			return r;
+		}
+
+		// Ϊn¿ռ䲢ԪأxΪʱͬʱĩβ*x
+		template<class Tuple>
+		void reallocate(size_type n, const Tuple* x);
+		void reallocate(size_type n) { reallocate(n, static_cast<const value_type*>(0)); }
+
+		// xñеԪأھɿռ֮ǰµһ
+		template<class Tuple>
+		void append(const Tuple& x) {
+			if (len == cap)
+				reallocate(next_capacity(len + 1), &x);
+			else
+				construct_row(len, x, std::integral_constant<size_t, 0>());
+			++len;
+		}
+
+	private:
+		soa_vector(const soa_vector&);
+		soa_vector& operator=(const soa_vector&);
+
+	public:
+		soa_vector() : cols(), len(0), cap(0) {}
+		~soa_vector() {
+			destroy_rows(0, len, columns());
+			deallocate(columns());
+		}
+
+		size_type size() const { return len; }
+		size_type capacity() const { return cap; }
+		bool empty() const { return len == 0; }
+
+		// n¼ֶtuple
+		reference operator[](size_type n) { return row(n, columns()); }
+		const_reference operator[](size_type n) const { return row(n, columns()); }
+		reference front() { return (*this)[0]; }
+		reference back() { return (*this)[len - 1]; }
+
+		// Iеͼ
+		template<size_t I>
+		span<typename column_type<I>::type> column() {
+			return span<typename column_type<I>::type>(column_data<I>(), len);
+		}
+		template<size_t I>
+		span<const typename column_type<I>::type> column() const {
+			return span<const typename column_type<I>::type>(column_data<I>(), len);
+		}
+
+		void push_back(const value_type& x) { append(x); }
+		// ÿֱڹһ
+		template<class... Args>
+		void emplace_back(const Args&... args) {
+			static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+			append(std::tuple<const Args&...>(args...));
+		}
+
+		void pop_back() {
+			--len;
+			destroy_rows(len, len + 1, columns());
+		}
+		void clear() {
+			destroy_rows(0, len, columns());
+			len = 0;
+		}
+		void reserve(size_type n) {
+			if (cap < n)
+				reallocate(n);
+		}
+		void resize(size_type new_size, const value_type& x) {
+			if (new_size < len) {
+				destroy_rows(new_size, len, columns());
+				len = new_size;
+			}
+			else {
+				reserve(new_size);
+				while (len < new_size)
+					append(x);
+			}
+		}
+		void resize(size_type new_size) {
+			resize(new_size, value_type());
+		}
+	};
+
+	template<class... Ts, class Alloc, class GrowthPolicy>
+	template<class Tuple, size_t I>
+	void soa_vector<std::tuple<Ts...>, Alloc, GrowthPolicy>::relocate_columns(column_pointers& to, size_type n,
+		const Tuple* x, std::integral_constant<size_t, I>)
+	{
+		typedef typename column_type<I>::type C;
+		typedef simple_alloc<C, Alloc> column_allocator;
+
+		C* p = column_allocator::allocate(n);
+		size_type built = len;
+		try {
+			if (x) {
+				construct(p + len, std::get<I>(*x));
+				built = len + 1;
+			}
+			uninitialized_copy(column_data<I>(), column_data<I>() + len, p);
+		}
+		catch (...) {
+			if (built != len)
+				destroy(p + len);
+			column_allocator::deallocate(p, n);
+			throw;
+		}
+		try {
+			relocate_columns(to, n, x, std::integral_constant<size_t, I + 1>());
+		}
+		catch (...) {
+			// "commit or rollback" semantics.
+			destroy(p, p + built);
+			column_allocator::deallocate(p, n);
+			throw;
+		}
+		std::get<I>(to) = p;
+	}
+
+	template<class... Ts, class Alloc, class GrowthPolicy>
+	template<class Tuple, size_t I>
+	void soa_vector<std::tuple<Ts...>, Alloc, GrowthPolicy>::construct_row(size_type pos, const Tuple& x,
+		std::integral_constant<size_t, I>)
+	{
+		typename column_type<I>::type* p = column_data<I>() + pos;
+		construct(p, std::get<I>(x));
+		try {
+			construct_row(pos, x, std::integral_constant<size_t, I + 1>());
+		}
+		catch (...) {
+			destroy(p);
+			throw;
+		}
+	}
+
+	template<class... Ts, class Alloc, class GrowthPolicy>
+	template<class Tuple>
+	void soa_vector<std::tuple<Ts...>, Alloc, GrowthPolicy>::reallocate(size_type n, const Tuple* x)
+	{
+		column_pointers new_cols;
+		relocate_columns(new_cols, n, x, std::integral_constant<size_t, 0>());
+
+		// оѰƳɹͷžɿռ
+		destroy_rows(0, len, columns());
+		deallocate(columns());
+		cols = new_cols;
+		cap = n;
+	}
+
+}
+
+#endif // !_CHUSTL_SOAVECTOR_H_
\ No newline at end of file
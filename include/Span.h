@@ -0,0 +1,48 @@
+#pragma once
+
+#ifndef _CHUSTL_SPAN_H_
+#define _CHUSTL_SPAN_H_
+
+#include <cstddef>
+
+namespace ChuSTL {
+
+	/*
+	* span: һԪصͼӵԪ
+	* ָͨ룬ֱӽ㷨
+	*/
+	template<class T>
+	class span {
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef T*				iterator;
+		typedef T&				reference;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+
+	protected:
+		pointer start;
+		size_type len;
+
+	public:
+		span() : start(0), len(0) {}
+		span(pointer p, size_type n) : start(p), len(n) {}
+		span(pointer first, pointer last) : start(first), len(size_type(last - first)) {}
+
+		iterator begin() const { return start; }
+		iterator end() const { return start + len; }
+		pointer data() const { return start; }
+		size_type size() const { return len; }
+		bool empty() const { return len == 0; }
+		reference operator[](size_type n) const { return start[n]; }
+		reference front() const { return *start; }
+		reference back() const { return start[len - 1]; }
+
+		// offsetʼnԪ
+		span subspan(size_type offset, size_type n) const { return span(start + offset, n); }
+	};
+
+}
+
+#endif // !_CHUSTL_SPAN_H_
\ No newline at end of file
@@ -0,0 +1,169 @@
+#pragma once
+
+#ifndef _CHUSTL_SPSCQUEUE_H_
+#define _CHUSTL_SPSCQUEUE_H_
+
+#include <atomic>
+#include <thread>
+
+#include "Allocator.h"
+#include "Alloc.h"
+
+namespace ChuSTL {
+
+	// и̷ֱ߳дֶΰиα
+	const size_t __cache_line_size = 64;
+
+	/*
+	* spsc_queue: ߵߵн
+	* push/try_push/push_nֻһ̵߳ãfront/pop/try_pop/pop_nֻһ̵߳
+	* tailֻдheadֻд߸ռһУreleaseдacquire
+	* ˫ԻԷ±ֻ꣬ڻֵʾѿʱ¶ȡƽʱʶԷĻ
+	* ΪСڹ2ݣռڹʱһ
+	*/
+	template<class T, class Alloc> // class Alloc = alloc
+	class spsc_queue {
+	public:
+		typedef T						value_type;
+		typedef T*						pointer;
+		typedef T&						reference;
+		typedef const T&				const_reference;
+		typedef size_t					size_type;
+
+	protected:
+		typedef simple_alloc<value_type, Alloc> data_allocator;
+
+		// ˫ֻ
+		pointer buf;
+		size_type cap;
+		// 
+		alignas(__cache_line_size) std::atomic<size_type> tail;
+		size_type cached_head;
+		// 
+		alignas(__cache_line_size) std::atomic<size_type> head;
+		size_type cached_tail;
+
+		pointer slot(size_type i) const { return buf + (i & (cap - 1)); }
+
+		// ߿õĿλheadnʱ¶ȡ
+		size_type free_slots(size_type t, size_type n) {
+			if (cap - (t - cached_head) < n)
+				cached_head = head.load(std::memory_order_acquire);
+			return cap - (t - cached_head);
+		}
+		// ߿ȡԪظtailnʱ¶ȡ
+		// pop()棬hԽtail˰зŲȽ
+		size_type ready_slots(size_type h, size_type n) {
+			if (ptrdiff_t(cached_tail - h) < ptrdiff_t(n))
+				cached_tail = tail.load(std::memory_order_acquire);
+			return cached_tail - h;
+		}
+
+	private:
+		spsc_queue(const spsc_queue&);
+		spsc_queue& operator=(const spsc_queue&);
+
+	public:
+		explicit spsc_queue(size_type n) : buf(0), cap(1), tail(0), cached_head(0), head(0), cached_tail(0) {
+			while (cap < n)
+				cap <<= 1;
+			buf = data_allocator::allocate(cap);
+		}
+		~spsc_queue() {
+			size_type t = tail.load(std::memory_order_relaxed);
+			for (size_type h = head.load(std::memory_order_relaxed); h != t; ++h)
+				destroy(slot(h));
+			data_allocator::deallocate(buf, cap);
+		}
+
+		size_type capacity() const { return cap; }
+		// һʱֻǽֵ
+		size_type size() const {
+			return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+		}
+		bool empty() const { return size() == 0; }
+
+		// ߣʱfalse
+		bool try_push(const value_type& x) {
+			size_type t = tail.load(std::memory_order_relaxed);
+			if (free_slots(t, 1) == 0)
+				return false;
+			construct(slot(t), x);
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+		// ߣʱȴڳλ
+		void push(const value_type& x) {
+			while (!try_push(x))
+				std::this_thread::yield();
+		}
+		// ߣfirstnԪأʵʷĸֻһtail
+		template<class InputIterator>
+		size_type push_n(InputIterator first, size_type n);
+
+		// ߣвΪ
+		reference front() { return *slot(head.load(std::memory_order_relaxed)); }
+		void pop() {
+			size_type h = head.load(std::memory_order_relaxed);
+			destroy(slot(h));
+			head.store(h + 1, std::memory_order_release);
+		}
+		// ߣΪʱfalseȡͷresult
+		bool try_pop(value_type& result) {
+			size_type h = head.load(std::memory_order_relaxed);
+			if (ready_slots(h, 1) == 0)
+				return false;
+			pointer p = slot(h);
+			result = *p;
+			destroy(p);
+			head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+		// ߣȡnԪдresultʵȡĸֻһhead
+		template<class OutputIterator>
+		size_type pop_n(OutputIterator result, size_type n);
+	};
+
+	template<class T, class Alloc>
+	template<class InputIterator>
+	typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::push_n(InputIterator first, size_type n)
+	{
+		size_type t = tail.load(std::memory_order_relaxed);
+		size_type room = free_slots(t, n);
+		if (n > room)
+			n = room;
+		size_type i = 0;
+		try {
+			for (; i != n; ++i, ++first)
+				construct(slot(t + i), *first);
+		}
+		catch (...) {
+			// "commit or rollback" semantics.
+			while (i--)
+				destroy(slot(t + i));
+			throw;
+		}
+		tail.store(t + n, std::memory_order_release);
+		return n;
+	}
+
+	template<class T, class Alloc>
+	template<class OutputIterator>
+	typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::pop_n(OutputIterator result, size_type n)
+	{
+		size_type h = head.load(std::memory_order_relaxed);
+		size_type ready = ready_slots(h, n);
+		if (n > ready)
+			n = ready;
+		for (size_type i = 0; i != n; ++i, ++result) {
+			pointer p = slot(h + i);
+			*result = *p;
+			destroy(p);
+		}
+		head.store(h + n, std::memory_order_release);
+		return n;
+	}
+
+}
+
+#endif // !_CHUSTL_SPSCQUEUE_H_
\ No newline at end of file
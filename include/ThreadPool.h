@@ -0,0 +1,404 @@
+#pragma once
+
+#ifndef _CHUSTL_THREADPOOL_H_
+#define _CHUSTL_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>		// for uintptr_t
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Iterator.h"
+#include "WorkStealingDeque.h"
+
+namespace ChuSTL {
+
+	// һforkȥĻϵ㣺δɵһ׳쳣
+	struct __task_group_state {
+		std::atomic<size_t> pending;
+		std::atomic<bool> failed;
+		std::exception_ptr error;
+
+		__task_group_state() : pending(0), failed(false) {}
+
+		void fail(std::exception_ptr e) {
+			bool expected = false;
+			if (failed.compare_exchange_strong(expected, true))
+				error = e;
+		}
+	};
+
+	// ԺִָвͷҪ麯
+	struct __pool_task {
+		void (*execute)(__pool_task*);
+		__task_group_state* group;
+	};
+
+	template<class Function, class Alloc>
+	struct __pool_task_impl : __pool_task {
+		typedef simple_alloc<__pool_task_impl, Alloc> task_allocator;
+
+		Function f;
+
+		__pool_task_impl(const Function& fn, __task_group_state* g) : f(fn) {
+			execute = &run;
+			group = g;
+		}
+
+		static void run(__pool_task* base) {
+			__pool_task_impl* self = static_cast<__pool_task_impl*>(base);
+			__task_group_state* g = self->group;
+			try {
+				self->f();
+			}
+			catch (...) {
+				g->fail(std::current_exception());
+			}
+			destroy(self);
+			task_allocator::deallocate(self);
+			// task_groupʱ
+			g->pending.fetch_sub(1, std::memory_order_release);
+		}
+	};
+
+	/*
+	* thread_pool: ȡ̳߳
+	* ÿ߳ӵһws_dequeforkѹԼbottom˲ȴȡ
+	* ȵľֲԣԼĶΪʱŴ̵߳topȡ硢ͨҲϴ
+	* û̹߳ĶС߳ύinjectedУʱȡֻsteal
+	* ҲĹ߳ҲߣֻдʱύŻ
+	* ʱִ߳ύ(ִڼfork)˳֮󲻵ٴӳύ
+	*/
+	template<class Alloc> // class Alloc = alloc
+	class thread_pool {
+	public:
+		typedef size_t size_type;
+
+	protected:
+		typedef ws_deque<__pool_task*, Alloc> task_deque;
+
+		struct worker {
+			thread_pool* pool;
+			size_type index;
+			task_deque tasks;
+			std::thread thread;
+
+			worker(thread_pool* p, size_type i) : pool(p), index(i) {}
+		};
+		typedef simple_alloc<char, Alloc> worker_allocator;
+
+		enum { spin_limit = 64 };
+
+		worker* workers;
+		char* worker_storage;	// workersڵĿռ䣬˶ֽ
+		size_type count;
+		task_deque injected;
+		std::mutex inject_mutex;
+		std::atomic<bool> stopping;
+		std::atomic<int> sleepers;
+		std::mutex sleep_mutex;
+		std::condition_variable wakeup;
+
+		// ǰ߳Ḷ́߳߳Ϊ0
+		static worker*& current() {
+			static thread_local worker* w = 0;
+			return w;
+		}
+		worker* self() {
+			worker* w = current();
+			return w && w->pool == this ? w : 0;
+		}
+		// workerںжĶУAllocֻ֤룬˶alignof(worker) - 1ֽںж
+		static size_type worker_bytes(size_type n) { return n * sizeof(worker) + alignof(worker) - 1; }
+		void allocate_workers(size_type n) {
+			worker_storage = worker_allocator::allocate(worker_bytes(n));
+			size_type offset = reinterpret_cast<uintptr_t>(worker_storage) % alignof(worker);
+			workers = reinterpret_cast<worker*>(worker_storage + (offset ? alignof(worker) - offset : 0));
+		}
+		void deallocate_workers(size_type n) {
+			worker_allocator::deallocate(worker_storage, worker_bytes(n));
+		}
+		static void worker_main(worker* w) {
+			current() = w;
+			w->pool->worker_loop(w);
+		}
+
+		// γԣԼĶСύ񡢴һ߳ȡ
+		bool find_task(worker* w, __pool_task*& t);
+		bool has_work() const;
+		void wake_one();
+		void worker_loop(worker* w);
+		// ֹͣǰṇ߳ύȫִϺŷ
+		void shutdown(size_type n);
+
+	private:
+		thread_pool(const thread_pool&);
+		thread_pool& operator=(const thread_pool&);
+
+	public:
+		// nΪ0ʱʹӲ߳
+		explicit thread_pool(size_type n = 0);
+		~thread_pool() { shutdown(count); }
+
+		size_type size() const { return count; }
+
+		// ߳ύԼĶУ߳ύinjected
+		void submit(__pool_task* t);
+		// ڵǰִ߳һûʱfalseȴϵ߳Դ˰æǿյ
+		bool run_one() {
+			__pool_task* t;
+			if (!find_task(self(), t))
+				return false;
+			t->execute(t);
+			return true;
+		}
+	};
+
+	template<class Alloc>
+	thread_pool<Alloc>::thread_pool(size_type n)
+		: workers(0), worker_storage(0), count(0), stopping(false), sleepers(0)
+	{
+		if (n == 0)
+			n = std::thread::hardware_concurrency();
+		if (n == 0)
+			n = 1;
+		allocate_workers(n);
+		size_type i = 0;
+		try {
+			for (; i != n; ++i)
+				new (&workers[i]) worker(this, i);
+			count = n;
+			for (i = 0; i != n; ++i)
+				workers[i].thread = std::thread(&worker_main, &workers[i]);
+		}
+		catch (...) {
+			// "commit or rollback" semantics.
+			if (count == 0) {
+				while (i--)
+					destroy(&workers[i]);
+				deallocate_workers(n);
+			}
+			else {
+				// ѹȫworkerֻǰi߳
+				shutdown(i);
+			}
+			throw;
+		}
+	}
+
+	template<class Alloc>
+	void thread_pool<Alloc>::shutdown(size_type n)
+	{
+		stopping.store(true);
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			wakeup.notify_all();
+		}
+		for (size_type i = 0; i != n; ++i)
+			workers[i].thread.join();
+		for (size_type i = 0; i != count; ++i)
+			destroy(&workers[i]);
+		deallocate_workers(count);
+	}
+
+	template<class Alloc>
+	bool thread_pool<Alloc>::find_task(worker* w, __pool_task*& t)
+	{
+		if (w && w->tasks.pop(t))
+			return true;
+		if (injected.steal(t))
+			return true;
+		size_type start = w ? w->index + 1 : 0;
+		for (size_type k = 0; k != count; ++k) {
+			worker* victim = &workers[(start + k) % count];
+			if (victim != w && victim->tasks.steal(t))
+				return true;
+		}
+		return false;
+	}
+
+	template<class Alloc>
+	bool thread_pool<Alloc>::has_work() const
+	{
+		if (!injected.empty())
+			return true;
+		for (size_type i = 0; i != count; ++i)
+			if (!workers[i].tasks.empty())
+				return true;
+		return false;
+	}
+
+	template<class Alloc>
+	void thread_pool<Alloc>::wake_one()
+	{
+		// ߷ԣҪô߷Ҫô￴
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleepers.load(std::memory_order_relaxed) != 0) {
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			wakeup.notify_one();
+		}
+	}
+
+	template<class Alloc>
+	void thread_pool<Alloc>::submit(__pool_task* t)
+	{
+		worker* w = self();
+		if (w) {
+			w->tasks.push(t);
+		}
+		else {
+			std::lock_guard<std::mutex> lock(inject_mutex);
+			injected.push(t);
+		}
+		wake_one();
+	}
+
+	template<class Alloc>
+	void thread_pool<Alloc>::worker_loop(worker* w)
+	{
+		int idle = 0;
+		for (;;) {
+			__pool_task* t;
+			if (find_task(w, t)) {
+				t->execute(t);
+				idle = 0;
+				continue;
+			}
+			// Ҳʱżstopping˳ǰеִ
+			// ԼĶֻб̻߳ѹ룬˳󲻻
+			if (stopping.load(std::memory_order_acquire))
+				break;
+			if (++idle < spin_limit) {
+				std::this_thread::yield();
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleep_mutex);
+			sleepers.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (!stopping.load() && !has_work())
+				wakeup.wait(lock);
+			sleepers.fetch_sub(1);
+			idle = 0;
+		}
+	}
+
+	/*
+	* task_group: fork/joinĻϵ
+	* run()񽻸̳߳أwait()ȵȫɣڼ䵱ǰ߳Ҳִо
+	* ׳ĵһ쳣wait()׳ʱȴ׳쳣
+	*/
+	template<class Alloc> // class Alloc = alloc
+	class task_group {
+	protected:
+		thread_pool<Alloc>& pool;
+		__task_group_state state;
+
+		void join() {
+			while (state.pending.load(std::memory_order_acquire) != 0)
+				if (!pool.run_one())
+					std::this_thread::yield();
+		}
+
+	private:
+		task_group(const task_group&);
+		task_group& operator=(const task_group&);
+
+	public:
+		explicit task_group(thread_pool<Alloc>& p) : pool(p) {}
+		~task_group() { join(); }
+
+		template<class Function>
+		void run(const Function& f) {
+			typedef __pool_task_impl<Function, Alloc> task;
+			task* t = task::task_allocator::allocate();
+			try {
+				new (t) task(f, &state);
+			}
+			catch (...) {
+				task::task_allocator::deallocate(t);
+				throw;
+			}
+			state.pending.fetch_add(1, std::memory_order_relaxed);
+			pool.submit(t);
+		}
+
+		void wait() {
+			join();
+			if (state.failed.load(std::memory_order_relaxed)) {
+				std::exception_ptr e = state.error;
+				state.error = std::exception_ptr();
+				state.failed.store(false, std::memory_order_relaxed);
+				std::rethrow_exception(e);
+			}
+		}
+	};
+
+	// ִfgg̳߳أfڵǰִ߳
+	template<class Alloc, class Function1, class Function2>
+	void parallel_invoke(thread_pool<Alloc>& pool, const Function1& f, const Function2& g) {
+		task_group<Alloc> group(pool);
+		group.run(g);
+		f();
+		group.wait();
+	}
+
+	template<class Alloc, class RandomAccessIterator, class Function>
+	void __parallel_for_range(thread_pool<Alloc>& pool, RandomAccessIterator first, RandomAccessIterator last,
+		const Function& f, size_t grain);
+
+	template<class Alloc, class RandomAccessIterator, class Function>
+	struct __parallel_for_task {
+		thread_pool<Alloc>* pool;
+		RandomAccessIterator first;
+		RandomAccessIterator last;
+		Function f;
+		size_t grain;
+
+		__parallel_for_task(thread_pool<Alloc>* p, RandomAccessIterator i, RandomAccessIterator j,
+			const Function& fn, size_t g) : pool(p), first(i), last(j), f(fn), grain(g) {}
+
+		void operator()() const { __parallel_for_range(*pool, first, last, f, grain); }
+	};
+
+	// ϰѺһforkȥǰһڱֱ̣߳grainԪʱ˳ִ
+	template<class Alloc, class RandomAccessIterator, class Function>
+	void __parallel_for_range(thread_pool<Alloc>& pool, RandomAccessIterator first, RandomAccessIterator last,
+		const Function& f, size_t grain) {
+		task_group<Alloc> group(pool);
+		while (size_t(last - first) > grain) {
+			RandomAccessIterator middle = first + (last - first) / 2;
+			group.run(__parallel_for_task<Alloc, RandomAccessIterator, Function>(&pool, middle, last, f, grain));
+			last = middle;
+		}
+		for (; first != last; ++first)
+			f(*first);
+		group.wait();
+	}
+
+	template<class Alloc, class RandomAccessIterator, class Function>
+	inline void __parallel_for(thread_pool<Alloc>& pool, RandomAccessIterator first, RandomAccessIterator last,
+		const Function& f, size_t grain, random_access_iterator_tag) {
+		if (grain == 0) {
+			// ÿ߳Լֵ8飬ȡƽ
+			grain = size_t(last - first) / (8 * pool.size());
+			if (grain == 0)
+				grain = 1;
+		}
+		__parallel_for_range(pool, first, last, f, grain);
+	}
+
+	// [first, last)ڵÿԪزеf(*i)grainΪ0ʱ߳ԶѡС
+	// ֻȡԱO(1)
+	template<class Alloc, class RandomAccessIterator, class Function>
+	inline void parallel_for(thread_pool<Alloc>& pool, RandomAccessIterator first, RandomAccessIterator last,
+		Function f, size_t grain = 0) {
+		__parallel_for(pool, first, last, f, grain, iterator_category(first));
+	}
+
+}
+
+#endif // !_CHUSTL_THREADPOOL_H_
\ No newline at end of file
@@ -3,8 +3,13 @@
 #ifndef _CHUSTL_TYPETRAITS_H
 #define _CHUSTL_TYPETRAITS_H
 
+#include <cstddef>
+#include <type_traits>
+
 namespace ChuSTL {
 
+	struct contiguous_iterator_tag;
+
 	template<class Iterator>
 	struct iterator_traits
 	{
@@ -15,11 +20,11 @@ namespace ChuSTL {
 		typedef typename Iterator::reference 			reference;
 	};
 
-	// ԭָƫػ汾
+	// ԭָƫػ汾ԭָ
 	template<class T>
 	struct iterator_traits<T*>
 	{
-		typedef random_access_iterator_tag	iterator_category;
+		typedef contiguous_iterator_tag		iterator_category;
 		typedef T							value_type;
 		typedef ptrdiff_t					difference_type;
 		typedef T*							pointer;
@@ -30,13 +35,24 @@ namespace ChuSTL {
 	template<class T>
 	struct iterator_traits<const T*>
 	{
-		typedef random_access_iterator_tag	iterator_category;
+		typedef contiguous_iterator_tag		iterator_category;
 		typedef T							value_type;
 		typedef ptrdiff_t					difference_type;
 		typedef const T*					pointer;
 		typedef const T&					reference;
 	};
 
+	// SGI__type_traitsԱṩstd::is_trivially_*жϣΪstd::true_typestd::false_type
+	template<class T>
+	struct __type_traits
+	{
+		typedef std::integral_constant<bool, std::is_trivially_default_constructible<T>::value>	has_trivial_default_constructor;
+		typedef std::integral_constant<bool, std::is_trivially_copy_constructible<T>::value>	has_trivial_copy_constructor;
+		typedef std::integral_constant<bool, std::is_trivially_copy_assignable<T>::value>		has_trivial_assignment_operator;
+		typedef std::integral_constant<bool, std::is_trivially_destructible<T>::value>			has_trivial_destructor;
+		typedef std::integral_constant<bool, std::is_trivial<T>::value>							is_POD_type;
+	};
+
 }
 
 #endif // !_CHUSTL_TYPETRAITS_H
@@ -3,55 +3,27 @@
 #ifndef _CHUSTL_UNINITIALIZED_H_
 #define _CHUSTL_UNINITIALIZED_H_
 
+#include <cstring>		// for memmove
+#include <type_traits>
+
+#include "Algorithm.h"
+#include "Allocator.h"		// for construct
 #include "Iterator.h"
 
 namespace ChuSTL {
 
-	/*
-	* ֺ"ԭ"ҪôеԪأҪôعκԪ
-	* һθƹ췢쳣ʱȫѲԪ
-	*/
-
-	// 뷶Χ[first, last)ڵÿһiΧ*iĸ
-	// construct(&*(result + (i - first)), *i)
-	template<class InputIterator, class ForwardIterator>
-	ForwardIterator uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result) {
-		return __uninitialized_copy(first, last, result, value_type(result));
-	}
-
-	// 뷶Χ[first, last)ڵÿһiixĸ
-	// construct(&*i, x)
-	template<class ForwardIterator, class T>
-	void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& x) {
-		__uninitialized_fill(first, last, x, value_type(first));
-	}
-
-	// 뷶Χ[first, first + n)ڵÿһiixĸ
-	// construct(&*i, x)
-	template<class ForwardIterator, class Size, class T>
-	ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T& x) {
-		return __uninitiallized_fill_n(first, n, x, value_type(first));
-	}
-
-
 	/*
 	* POD->Plain Old Data (ͳC struct)
 	* PODͱȻӵtrivial ctor/dtor/copy/assignment 
 	* ˶PODͲЧʵַnon-PODͲհȫַ
 	* ҵPODʱƹͬڸֵtrivialʱЧ
+	* PODͽcopy/fill/fill_nʱǽһmemmove/memset
 	*/
 
-	template<class InputIterator, class ForwardIterator, class T>
-	inline ForwardIterator
-		__uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result, T*) {
-		typedef typename __type_traits<T>::is_POD_type is_POD;
-		return __uninitialized_copy_aux(first, last, result, is_POD());
-	}
-
 	template<class InputIterator, class ForwardIterator>
 	inline ForwardIterator
 		__uninitialized_copy_aux(InputIterator first, InputIterator last, ForwardIterator result, std::true_type) { // __true_type
-		return copy(first, last, result);
+		return ChuSTL::copy(first, last, result);
 	}
 
 	template<class InputIterator, class ForwardIterator>
@@ -64,21 +36,17 @@ namespace ChuSTL {
 		return cur;
 	}
 
-	// char*wchar_t*ػ
-	inline char* uninitialized_copy(const char* first, const char* last, char* result);
-	inline wchar_t* uninitialized_copy(const wchar_t* first, const wchar_t* last, wchar_t* result);
-
-	template<class ForwardIterator, class T, class T1>
-	inline void 
-		__uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& x, T1*) {
-		// typedef typename __type_traits<T1>::is_POD_type is_POD;
-		__uninitialized_fill_aux(first, last, x, std::is_pod(T1)); // is_POD
+	template<class InputIterator, class ForwardIterator, class T>
+	inline ForwardIterator
+		__uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result, T*) {
+		// typedef typename __type_traits<T>::is_POD_type is_POD;
+		return __uninitialized_copy_aux(first, last, result, typename std::is_trivial<T>::type()); // is_POD
 	}
 
 	template<class ForwardIterator, class T>
 	inline void
 		__uninitialized_fill_aux(ForwardIterator first, ForwardIterator last, const T& x, std::true_type) { // __true_type
-		fill(first, last, x);
+		ChuSTL::fill(first, last, x);
 	}
 
 	template<class ForwardIterator, class T>
@@ -90,17 +58,17 @@ namespace ChuSTL {
 		}
 	}
 
-	template<class ForwardIterator, class Size, class T, class T1>
-	inline ForwardIterator 
-		__uninitialized_fill_n(ForwardIterator first, Size n, const T& x, T1*) {
+	template<class ForwardIterator, class T, class T1>
+	inline void 
+		__uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& x, T1*) {
 		// typedef typename __type_traits<T1>::is_POD_type is_POD;
-		return __uninitialized_fill_n_aux(first, n, x, std::is_pod(T1)); // is_POD()
+		__uninitialized_fill_aux(first, last, x, typename std::is_trivial<T1>::type()); // is_POD
 	}
 
 	template<class ForwardIterator, class Size, class T>
 	inline ForwardIterator 
 		__uninitialized_fill_n_aux(ForwardIterator first, Size n, const T& x, std::true_type) { // __true_type
-		return fill_n(first, n, x);
+		return ChuSTL::fill_n(first, n, x);
 	}
 		
 	template<class ForwardIterator, class Size, class T>
@@ -113,8 +81,49 @@ namespace ChuSTL {
 		return cur;
 	}
 
-	
+	template<class ForwardIterator, class Size, class T, class T1>
+	inline ForwardIterator 
+		__uninitialized_fill_n(ForwardIterator first, Size n, const T& x, T1*) {
+		// typedef typename __type_traits<T1>::is_POD_type is_POD;
+		return __uninitialized_fill_n_aux(first, n, x, typename std::is_trivial<T1>::type()); // is_POD()
+	}
+
+	/*
+	* ֺ"ԭ"ҪôеԪأҪôعκԪ
+	* һθƹ췢쳣ʱȫѲԪ
+	*/
+
+	// 뷶Χ[first, last)ڵÿһiΧ*iĸ
+	// construct(&*(result + (i - first)), *i)
+	template<class InputIterator, class ForwardIterator>
+	ForwardIterator uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result) {
+		return __uninitialized_copy(first, last, result, value_type(result));
+	}
+
+	// 뷶Χ[first, last)ڵÿһiixĸ
+	// construct(&*i, x)
+	template<class ForwardIterator, class T>
+	void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& x) {
+		__uninitialized_fill(first, last, x, value_type(first));
+	}
+
+	// 뷶Χ[first, first + n)ڵÿһiixĸ
+	// construct(&*i, x)
+	template<class ForwardIterator, class Size, class T>
+	ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T& x) {
+		return __uninitialized_fill_n(first, n, x, value_type(first));
+	}
+
+	// char*wchar_t*ػ
+	inline char* uninitialized_copy(const char* first, const char* last, char* result) {
+		memmove(result, first, last - first);
+		return result + (last - first);
+	}
 
+	inline wchar_t* uninitialized_copy(const wchar_t* first, const wchar_t* last, wchar_t* result) {
+		memmove(result, first, sizeof(wchar_t) * (last - first));
+		return result + (last - first);
+	}
 
 }
 
@@ -0,0 +1,524 @@
+#pragma once
+
+#ifndef _CHUSTL_UNROLLEDLIST_H
+#define _CHUSTL_UNROLLEDLIST_H
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "Iterator.h"
+#include "Uninitialized.h"
+
+namespace ChuSTL {
+
+	// nΪ0nʾڵûԶ
+	// nΪ0ʾʹĬֵڵԪԼ256ֽڣԪش256ֽʱÿڵһԪ
+	template<size_t n, size_t sz>
+	struct __unrolled_node_cap {
+		enum { value = n != 0 ? n : (sz < 256 ? 256 / sz : 1) };
+	};
+
+	// ڵӲ֣ͷڵֻһ֣countΪ0
+	struct __unrolled_node_base {
+		__unrolled_node_base* prev;
+		__unrolled_node_base* next;
+		size_t count;	// ڵڵԪظ
+	};
+
+	template<class T, size_t Cap>
+	struct __unrolled_node : public __unrolled_node_base {
+		alignas(T) unsigned char storage[sizeof(T) * Cap];
+
+		T* data() { return reinterpret_cast<T*>(storage); }
+	};
+
+	// ɽڵڵ±ɣ±ʼСڽڵcountend()Ϊ(ͷڵ, 0)
+	template<class T, class Ref, class Ptr, size_t Cap>
+	struct __unrolled_list_iterator {
+		typedef T														value_type;
+		typedef Ptr														pointer;
+		typedef Ref														reference;
+		typedef size_t													size_type;
+		typedef ptrdiff_t												difference_type;
+
+		typedef bidirectional_iterator_tag								iterator_category;
+		typedef __unrolled_list_iterator<T, Ref, Ptr, Cap>				self;
+		typedef __unrolled_list_iterator<T, T&, T*, Cap>				iterator;
+		typedef __unrolled_list_iterator<T, const T&, const T*, Cap>	const_iterator;
+		typedef __unrolled_node_base*									link_type;
+
+		link_type node;
+		size_type index;
+
+		__unrolled_list_iterator() : node(0), index(0) {}
+		__unrolled_list_iterator(link_type x, size_type i) : node(x), index(i) {}
+		__unrolled_list_iterator(const iterator& x) : node(x.node), index(x.index) {}
+
+		bool operator==(const self& x) const {
+			return node == x.node && index == x.index;
+		}
+		bool operator!=(const self& x) const {
+			return node != x.node || index != x.index;
+		}
+		reference operator*() const {
+			return static_cast<__unrolled_node<T, Cap>*>(node)->data()[index];
+		}
+		pointer operator->() const {
+			return &(operator*());
+		}
+		// ڵƶ±꣬Խڵ߽ʱָǰ
+		self& operator++() {
+			if (++index == node->count) {
+				node = node->next;
+				index = 0;
+			}
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+		self& operator--() {
+			if (index == 0) {
+				node = node->prev;
+				index = node->count;
+			}
+			--index;
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			--*this;
+			return tmp;
+		}
+	};
+
+	/*
+	* unrolled_list: ÿڵһСԪصĻ״˫
+	* ʱ󲿷ֲֻǽڵڵ±һָ׷ĴΪlist1/NodeCap
+	* ʱڵһΪɾڵ̺ϲ
+	* splice/merge/sort/reverselistͬԽڵΪλtransfer֮
+	* splice˰ѽڵпӺϺٰѹСڽڵϲ
+	*/
+	template<class T, class Alloc, size_t NodeCap = 0> // Alloc = alloc
+	class unrolled_list {
+	public:
+		enum { node_capacity = __unrolled_node_cap<NodeCap, sizeof(T)>::value };
+
+		typedef T																value_type;
+		typedef T*																pointer;
+		typedef T&																reference;
+		typedef const T&														const_reference;
+		typedef size_t															size_type;
+		typedef ptrdiff_t														difference_type;
+		typedef __unrolled_list_iterator<T, T&, T*, node_capacity>				iterator;
+		typedef __unrolled_list_iterator<T, const T&, const T*, node_capacity>	const_iterator;
+
+	protected:
+		typedef __unrolled_node_base						node_base;
+		typedef __unrolled_node<T, node_capacity>			list_node;
+		typedef node_base*									link_type;
+		// רռֱͷڵݽڵ
+		typedef simple_alloc<node_base, Alloc>				header_allocator;
+		typedef simple_alloc<list_node, Alloc>				list_node_allocator;
+
+		// nodeָͷڵ㣬STLǰպ
+		link_type node;
+
+		static T* data(link_type p) { return static_cast<list_node*>(p)->data(); }
+
+		// һյݽڵ㲢position֮ǰ
+		link_type create_node(link_type position) {
+			link_type p = list_node_allocator::allocate();
+			p->count = 0;
+			p->next = position;
+			p->prev = position->prev;
+			position->prev->next = p;
+			position->prev = p;
+			return p;
+		}
+		void unlink_node(link_type p) {
+			p->prev->next = p->next;
+			p->next->prev = p->prev;
+		}
+		// ڵȫԪزͷŽڵ㣬ڵժ
+		void destroy_node(link_type p) {
+			destroy(data(p), data(p) + p->count);
+			list_node_allocator::deallocate(static_cast<list_node*>(p));
+		}
+
+		void empty_initialize() {
+			node = header_allocator::allocate();
+			node->next = node;
+			node->prev = node;
+			node->count = 0;
+		}
+
+		// pĵiλðxp뻹пλ
+		void insert_into(link_type p, size_type i, const T& x);
+		// ɾpĵiԪأڵջϲ
+		void erase_from(link_type p, size_type i);
+		// p[k, count)ᵽ½ĺ̽ڵϣظýڵ
+		link_type split(link_type p, size_type k);
+		// p̵ԪʱѺ̲p
+		void coalesce(link_type p);
+		// ʹitΪڵ㣬Ҫʱпڵ㣻otherָλ֮itڵĽڵ
+		link_type split_at(iterator& it, iterator& other1, iterator& other2);
+		// pǰnԪزԪǰ
+		void drop_front(link_type p, size_type n);
+
+		// [first, last)֮ĽڵƵposition֮ǰ߶ǽڵ
+		void transfer(link_type position, link_type first, link_type last) {
+			if (position != last && first != last) {
+				last->prev->next = position;
+				first->prev->next = last;
+				position->prev->next = first;
+				link_type tmp = position->prev;
+				position->prev = last->prev;
+				last->prev = first->prev;
+				first->prev = tmp;
+			}
+		}
+
+	public:
+		unrolled_list() { empty_initialize(); }
+		unrolled_list(const unrolled_list& x) {
+			empty_initialize();
+			for (const_iterator i = x.begin(); i != x.end(); ++i)
+				push_back(*i);
+		}
+		~unrolled_list() {
+			clear();
+			header_allocator::deallocate(node);
+		}
+		unrolled_list& operator=(const unrolled_list& x) {
+			if (this != &x) {
+				unrolled_list tmp(x);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		iterator begin() { return iterator(node->next, 0); }
+		const_iterator begin() const { return const_iterator(iterator(node->next, 0)); }
+		iterator end() { return iterator(node, 0); }
+		const_iterator end() const { return const_iterator(iterator(node, 0)); }
+		bool empty() const { return node->next == node; }
+		size_type size() const {
+			size_type result = 0;
+			for (link_type p = node->next; p != node; p = p->next)
+				result += p->count;
+			return result;
+		}
+		reference front() { return *begin(); }
+		reference back() { return *(--end()); }
+
+		iterator insert(iterator position, const T& x);
+		void push_front(const T& x) { insert(begin(), x); }
+		void push_back(const T& x) { insert(end(), x); }
+		iterator erase(iterator position);
+		void pop_front() { erase(begin()); }
+		void pop_back() { erase(--end()); }
+		void clear();
+		void swap(unrolled_list& x) {
+			link_type tmp = node;
+			node = x.node;
+			x.node = tmp;
+		}
+
+		// xӺpositionָλ֮ǰx벻ͬ*this
+		void splice(iterator position, unrolled_list& x) {
+			if (!x.empty())
+				splice(position, x, x.begin(), x.end());
+		}
+		// iָԪؽӺpositionָλ֮ǰ
+		void splice(iterator position, unrolled_list& x, iterator i) {
+			iterator j = i;
+			++j;
+			if (position == i || position == j)
+				return;
+			splice(position, x, i, j);
+		}
+		// [first, last)ڵԪؽӺpositionָλ֮ǰpositionλ[first, last)֮
+		void splice(iterator position, unrolled_list& x, iterator first, iterator last);
+		void merge(unrolled_list& x); // xϲ*thisϣ߱ѵ
+		void reverse();
+		void sort();
+	};
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::insert_into(link_type p, size_type i, const T& x)
+	{
+		T* d = data(p);
+		size_type c = p->count;
+		if (i == c) {
+			construct(d + c, x);
+		}
+		else {
+			// vector::insert_auxͬһԪβ˹죬
+			T x_copy = x;
+			construct(d + c, d[c - 1]);
+			ChuSTL::copy_backward(d + i, d + c - 1, d + c);
+			d[i] = x_copy;
+		}
+		++p->count;
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::erase_from(link_type p, size_type i)
+	{
+		T* d = data(p);
+		ChuSTL::copy(d + i + 1, d + p->count, d + i);
+		--p->count;
+		destroy(d + p->count);
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	typename unrolled_list<T, Alloc, NodeCap>::link_type
+	unrolled_list<T, Alloc, NodeCap>::split(link_type p, size_type k)
+	{
+		link_type q = create_node(p->next);
+		size_type n = p->count - k;
+		try {
+			uninitialized_copy(data(p) + k, data(p) + p->count, data(q));
+		}
+		catch (...) {
+			unlink_node(q);
+			list_node_allocator::deallocate(static_cast<list_node*>(q));
+			throw;
+		}
+		destroy(data(p) + k, data(p) + p->count);
+		p->count = k;
+		q->count = n;
+		return q;
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::coalesce(link_type p)
+	{
+		link_type q = p->next;
+		if (p == node || q == node || p->count + q->count > size_type(node_capacity))
+			return;
+		uninitialized_copy(data(q), data(q) + q->count, data(p) + p->count);
+		p->count += q->count;
+		unlink_node(q);
+		destroy_node(q);
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	typename unrolled_list<T, Alloc, NodeCap>::link_type
+	unrolled_list<T, Alloc, NodeCap>::split_at(iterator& it, iterator& other1, iterator& other2)
+	{
+		if (it.index == 0)
+			return it.node;
+		link_type p = it.node;
+		size_type k = it.index;
+		link_type q = split(p, k);
+		// λе֮ĵΪָ½ڵ
+		if (other1.node == p && other1.index >= k) {
+			other1.node = q;
+			other1.index -= k;
+		}
+		if (other2.node == p && other2.index >= k) {
+			other2.node = q;
+			other2.index -= k;
+		}
+		it = iterator(q, 0);
+		return q;
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::drop_front(link_type p, size_type n)
+	{
+		T* d = data(p);
+		ChuSTL::copy(d + n, d + p->count, d);
+		destroy(d + p->count - n, d + p->count);
+		p->count -= n;
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	typename unrolled_list<T, Alloc, NodeCap>::iterator
+	unrolled_list<T, Alloc, NodeCap>::insert(iterator position, const T& x)
+	{
+		link_type p = position.node;
+		size_type i = position.index;
+		// ڽڵʱǰһڵ㻹пλ׷ӵβ
+		if (i == 0 && p->prev != node && p->prev->count < size_type(node_capacity)) {
+			p = p->prev;
+			i = p->count;
+		}
+		else if (p == node) {
+			// βһڵlistΪգ
+			p = create_node(node);
+		}
+		else if (p->count == size_type(node_capacity)) {
+			// ڵһΪ嵽Ӧһ롣xܾǸýڵеԪأпǰȸ
+			T x_copy = x;
+			const size_type half = size_type(node_capacity) / 2;
+			link_type q = split(p, half);
+			if (i > half) {
+				p = q;
+				i -= half;
+			}
+			insert_into(p, i, x_copy);
+			return iterator(p, i);
+		}
+		insert_into(p, i, x);
+		return iterator(p, i);
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	typename unrolled_list<T, Alloc, NodeCap>::iterator
+	unrolled_list<T, Alloc, NodeCap>::erase(iterator position)
+	{
+		link_type p = position.node;
+		size_type i = position.index;
+		erase_from(p, i);
+		if (p->count == 0) {
+			link_type next = p->next;
+			unlink_node(p);
+			destroy_node(p);
+			return iterator(next, 0);
+		}
+		// ڵķ֮һʱԲ
+		if (p->count < size_type(node_capacity) / 4)
+			coalesce(p);
+		if (i < p->count)
+			return iterator(p, i);
+		return iterator(p->next, 0);
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::clear()
+	{
+		link_type cur = node->next;
+		while (cur != node) {
+			link_type tmp = cur;
+			cur = cur->next;
+			destroy_node(tmp);
+		}
+		node->next = node;
+		node->prev = node;
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::splice(iterator position, unrolled_list& x, iterator first, iterator last)
+	{
+		if (first == last || position == first || position == last)
+			return;
+		// Ȱλöгɽڵ㣬ֻ֮ڵtransfer
+		split_at(position, first, last);
+		link_type last_node = split_at(last, position, first);
+		link_type first_node = split_at(first, position, last);
+		link_type pos_node = position.node;
+		link_type before = first_node->prev;
+
+		transfer(pos_node, first_node, last_node);
+
+		// Ӻϴ¹СĽڵ㣬ܺϲľͺϲȴxµȱڣٴӺϵ
+		x.coalesce(before);
+		coalesce(pos_node->prev);
+		coalesce(first_node->prev);
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::merge(unrolled_list& x)
+	{
+		if (this == &x)
+			return;
+		// ÿδxǰȡһζС*first1Ԫأڵtransferfirst1֮ǰ
+		// ֻfirst1ڵĽڵxиöĩβĽڵҪпԪزƶ
+		iterator first1 = begin();
+		while (!x.empty()) {
+			const T& v = data(x.node->next)[0];
+			while (first1.node != node && !(v < *first1))
+				++first1;
+			if (first1.node == node) {
+				// ԪضС*thisһԪأӵβ
+				link_type tail = node->prev;
+				transfer(node, x.node->next, x.node);
+				coalesce(tail);
+				return;
+			}
+			// ҳxС*first1ǰ׺ֹڽڵrun_endĵkԪ֮ǰ
+			link_type run_end = x.node->next;
+			size_type k = 0;
+			while (run_end != x.node && data(run_end)[run_end->count - 1] < *first1)
+				run_end = run_end->next;
+			if (run_end != x.node) {
+				while (data(run_end)[k] < *first1)
+					++k;
+				if (k != 0)
+					run_end = x.split(run_end, k);
+			}
+			if (first1.index != 0) {
+				split(first1.node, first1.index);
+				first1 = iterator(first1.node->next, 0);
+			}
+			link_type pos = first1.node;
+			link_type run_first = x.node->next;
+			transfer(pos, run_first, run_end);
+			// һܲǰµİڵͲ룬ֻһεԪ
+			coalesce(run_first->prev);
+		}
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::reverse()
+	{
+		// ÿڵڲٽнڵ㣨ͷڵ㣩prevnext
+		link_type p = node;
+		do {
+			T* d = data(p);
+			for (size_type i = 0, j = p->count; i + 1 < j; ++i, --j) {
+				T tmp = d[i];
+				d[i] = d[j - 1];
+				d[j - 1] = tmp;
+			}
+			link_type tmp = p->next;
+			p->next = p->prev;
+			p->prev = tmp;
+			p = tmp;
+		} while (p != node);
+	}
+
+	template<class T, class Alloc, size_t NodeCap>
+	void unrolled_list<T, Alloc, NodeCap>::sort()
+	{
+		if (node->next == node || (node->next->next == node && node->next->count < 2))
+			return;
+		// ȶÿڵڵԪ
+		for (link_type p = node->next; p != node; p = p->next) {
+			T* d = data(p);
+			for (size_type i = 1; i < p->count; ++i) {
+				T value = d[i];
+				size_type j = i;
+				for (; j > 0 && value < d[j - 1]; --j)
+					d[j] = d[j - 1];
+				d[j] = value;
+			}
+		}
+		// ڵΪλlist::sortķʽ鲢
+		unrolled_list carry;
+		unrolled_list counter[64];
+		int fill = 0;
+		while (!empty()) {
+			carry.transfer(carry.node, node->next, node->next->next);
+			int i = 0;
+			while (i < fill && !counter[i].empty()) {
+				counter[i].merge(carry);
+				carry.swap(counter[i++]);
+			}
+			carry.swap(counter[i]);
+			if (i == fill)
+				++fill;
+		}
+
+		for (int i = 1; i < fill; i++)
+			counter[i].merge(counter[i - 1]);
+		swap(counter[fill - 1]);
+	}
+
+}
+
+#endif // !_CHUSTL_UNROLLEDLIST_H
\ No newline at end of file
@@ -6,10 +6,63 @@
 #include "Allocator.h"
 #include "Alloc.h"
 #include "Iterator.h"
+#include "Uninitialized.h"
+
+#include <type_traits>	// for is_integral
 
 namespace ChuSTL {
 
-	template<class T, class Alloc> // class Alloc = alloc
+	/*
+	* ԣÿռ䲻ʱõԪظ
+	* next_capacity(old_size, min_size, elem_size)زСmin_size
+	*/
+
+	// ɳȵSGIĬ
+	struct vector_growth_x2 {
+		static size_t next_capacity(size_t old_size, size_t min_size, size_t) {
+			size_t len = 2 * old_size;
+			return len < min_size ? min_size : len;
+		}
+	};
+
+	// ɳȵ1.5¿ռСڴǰͷŵĸ֮ͣлḴþɿ
+	struct vector_growth_x1_5 {
+		static size_t next_capacity(size_t old_size, size_t min_size, size_t) {
+			size_t len = old_size + old_size / 2;
+			return len < min_size ? min_size : len;
+		}
+	};
+
+	// BaseĻϽֽȡsize classβռ䲻˷
+	// 128ֽڰ8ֽڶ루allocfree listһ£Ŀ齫[2^k, 2^(k+1)]ĵȷ
+	template<class Base = vector_growth_x2>
+	struct vector_growth_size_class {
+		static size_t next_capacity(size_t old_size, size_t min_size, size_t elem_size) {
+			size_t bytes = Base::next_capacity(old_size, min_size, elem_size) * elem_size;
+			size_t step = 8;
+			if (bytes > 128) {
+				size_t upper = 256;
+				while (upper < bytes)
+					upper <<= 1;
+				step = upper >> 3;
+			}
+			return ((bytes + step - 1) & ~(step - 1)) / elem_size;
+		}
+	};
+
+	// BaseĻϣһһҳͽֽȡҳvector°ҳβ
+	template<size_t PageSize = 4096, class Base = vector_growth_x2>
+	struct vector_growth_page {
+		static size_t next_capacity(size_t old_size, size_t min_size, size_t elem_size) {
+			size_t len = Base::next_capacity(old_size, min_size, elem_size);
+			size_t bytes = len * elem_size;
+			if (bytes < PageSize)
+				return len;
+			return ((bytes + PageSize - 1) & ~(PageSize - 1)) / elem_size;
+		}
+	};
+
+	template<class T, class Alloc, class GrowthPolicy = vector_growth_x2> // class Alloc = alloc
 	class vector {
 	public:
 		typedef T								value_type;
@@ -34,6 +87,68 @@ namespace ChuSTL {
 		void insert_aux(iterator position, const T& x);
 		void insert(iterator position, size_type n, const T& x);
 
+		// Ծmin_sizeԪʱӦõĴС
+		size_type next_capacity(size_type min_size) const {
+			return GrowthPolicy::next_capacity(size(), min_size, sizeof(T));
+		}
+
+		// lenԪص¿ռ䲢ԪذȥlenСsize()
+		void reallocate(size_type len);
+
+		template<class InputIterator>
+		void assign_aux(InputIterator first, InputIterator last, std::false_type) {
+			range_assign(first, last, iterator_category(first));
+		}
+		template<class Integer>
+		void assign_aux(Integer n, Integer value, std::true_type) {
+			assign(size_type(n), value_type(value));
+		}
+		template<class InputIterator>
+		void range_assign(InputIterator first, InputIterator last, input_iterator_tag);
+		template<class ForwardIterator>
+		void range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+		template<class InputIterator>
+		void insert_dispatch(iterator position, InputIterator first, InputIterator last, std::false_type) {
+			range_insert(position, first, last, iterator_category(first));
+		}
+		template<class Integer>
+		void insert_dispatch(iterator position, Integer n, Integer value, std::true_type) {
+			insert(position, size_type(n), value_type(value));
+		}
+		// ޷Ԥ֪ȣֻ壬̯
+		template<class InputIterator>
+		void range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+			for (; first != last; ++first) {
+				position = insert(position, *first);
+				++position;
+			}
+		}
+		// ǰdistanceȣһ
+		template<class ForwardIterator>
+		void range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+
+		template<class InputIterator>
+		void range_initialize(InputIterator first, InputIterator last, input_iterator_tag) {
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+		template<class ForwardIterator>
+		void range_initialize(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+			size_type n = distance(first, last);
+			start = allocate_and_copy(n, first, last);
+			finish = start + n;
+			end_of_storage = finish;
+		}
+		template<class Integer>
+		void initialize_dispatch(Integer n, Integer value, std::true_type) {
+			fill_initialize(size_type(n), value_type(value));
+		}
+		template<class InputIterator>
+		void initialize_dispatch(InputIterator first, InputIterator last, std::false_type) {
+			range_initialize(first, last, iterator_category(first));
+		}
+
 		void deallocate() {
 			if (start) {
 				data_allocator::deallocate(start, end_of_storage - start);
@@ -54,15 +169,29 @@ namespace ChuSTL {
 			return result;
 		}
 
+		// ö[first, last)nΪ䳤
+		template<class ForwardIterator>
+		iterator allocate_and_copy(size_type n, ForwardIterator first, ForwardIterator last) {
+			iterator result = data_allocator::allocate(n);
+			try {
+				uninitialized_copy(first, last, result);
+			}
+			catch (...) {
+				data_allocator::deallocate(result, n);
+				throw;
+			}
+			return result;
+		}
+
 	public:
 		iterator begin() { return start; }
 		const_iterator cbegin() const { return start; }
 		iterator end() { return finish; }
 		const_iterator cend() const { return finish; }
 
-		size_type size() const { return size_type(end() - begin()); }
-		size_type capacity() const { return size_type(end_of_storage - begin()); }
-		bool empty() const { return begin() = end(); }
+		size_type size() const { return size_type(finish - start); }
+		size_type capacity() const { return size_type(end_of_storage - start); }
+		bool empty() const { return start == finish; }
 		reference operator[](size_type n) { return *(begin() + n); }
 		const_reference operator[](size_type n) const { return *(cbegin() + n); }
 
@@ -72,6 +201,11 @@ namespace ChuSTL {
 		vector(int n, const T& value) { fill_initialize(n, value); }
 		vector(long n, const T& value) { fill_initialize(n, value); }
 		explicit vector(size_type n) { fill_initialize(n, T()); }
+		// [first, last)죬Ϊʱͬvector(n, value)
+		template<class InputIterator>
+		vector(InputIterator first, InputIterator last) : start(0), finish(0), end_of_storage(0) {
+			initialize_dispatch(first, last, typename std::is_integral<InputIterator>::type());
+		}
 
 		~vector() {
 			destroy(start, finish);
@@ -91,6 +225,29 @@ namespace ChuSTL {
 			}
 		}
 
+		// position֮ǰxָԪصĵ
+		iterator insert(iterator position, const T& x) {
+			size_type n = position - begin();
+			if (finish != end_of_storage && position == end()) {
+				construct(finish, x);
+				++finish;
+			}
+			else {
+				insert_aux(position, x);
+			}
+			return begin() + n;
+		}
+		// position֮ǰ[first, last)
+		template<class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last) {
+			insert_dispatch(position, first, last, typename std::is_integral<InputIterator>::type());
+		}
+		// [first, last)׷ӵβ
+		template<class InputIterator>
+		void append_range(InputIterator first, InputIterator last) {
+			insert(end(), first, last);
+		}
+
 		void pop_back() {	// Ԫȡ
 			--finish;
 			destroy(finish);
@@ -98,14 +255,14 @@ namespace ChuSTL {
 
 		iterator erase(iterator position) {	// ĳλϵԪ
 			if (position + 1 != end()) {
-				copy(position + 1, finish, position);	// Ԫǰ
+				ChuSTL::copy(position + 1, finish, position);	// Ԫǰ
 			}
 			--finish;
 			destroy(finish);
 			return position;
 		}
 		iterator erase(iterator first, iterator last) { // [first, last)еԪ
-			iterator i = copy(last, finish, first);
+			iterator i = ChuSTL::copy(last, finish, first);
 			destroy(i, finish);
 			finish = finish - (last - first);
 			return first;
@@ -123,12 +280,27 @@ namespace ChuSTL {
 			erase(begin(), end());
 		}
 
-		/*
+		// ԤnԪصĿռ䣬ncapacity()ʱʲô
+		void reserve(size_type n) {
+			if (capacity() < n)
+				reallocate(n);
+		}
+		// ͷűÿռ䣬ʹcapacity() == size()
+		void shrink_to_fit() {
+			if (finish != end_of_storage)
+				reallocate(size());
+		}
 
+		// nxȡ
+		void assign(size_type n, const T& x);
+		// [first, last)ȡݣתassign(n, x)
 		template<class InputIterator>
-		vector(InputIterator first, InputIterator last);
-		template<class Integer>
-		vector_aux(Integer n, const T& value, std::true_type);
+		void assign(InputIterator first, InputIterator last) {
+			assign_aux(first, last, typename std::is_integral<InputIterator>::type());
+		}
+
+		/*
+
 		vector(const vector& v);
 		vector<T, Alloc>& operator=(const vector& v);
 
@@ -137,30 +309,23 @@ namespace ChuSTL {
 		reverse_iterator rbegin();
 		const_reverse_iterator crbegin() const;
 
-		void reserve(size_type n);
-
-		template<class InputIterator>
-		void reallocateAndCopy(iterator position, InputIterator first, InputIterator last);
-
 		*/
 	};
 
-	template<class T, class Alloc>
-	void vector<T, Alloc>::insert_aux(iterator position, const T& x)
+	template<class T, class Alloc, class GrowthPolicy>
+	void vector<T, Alloc, GrowthPolicy>::insert_aux(iterator position, const T& x)
 	{
 		if (finish != end_of_storage) {
 			// ڱÿռʼһԪأvectorһԪֵΪֵ
-			construct(finish, *(finish - 1);
+			construct(finish, *(finish - 1));
 			++finish;
 			T x_copy = x;
-			copy_backward(position, finish - 2, finish - 1);
+			ChuSTL::copy_backward(position, finish - 2, finish - 1);
 			*position = x_copy;
 		}
 		else {
-			const size_type old_size = size();
-			const size_type len = old_size != 0 ? 2 * old_size : 1;
-			// ԭСΪ01ԪشС
-			// ԭСΪ0ԭС
+			// Ծ³ȣĬΪԭСԭСΪ0ʱ1Ԫأ
+			const size_type len = next_capacity(size() + 1);
 
 			iterator new_start = data_allocator::allocate(len);
 			iterator new_finish = new_start;
@@ -192,8 +357,8 @@ namespace ChuSTL {
 		}
 	}
 
-	template<class T, class Alloc>
-	void vector<T, Alloc>::insert(iterator position, size_type n, const T& x)
+	template<class T, class Alloc, class GrowthPolicy>
+	void vector<T, Alloc, GrowthPolicy>::insert(iterator position, size_type n, const T& x)
 	{
 		if (n != 0) {
 			if (size_type(end_of_storage - finish) >= n) {
@@ -206,8 +371,8 @@ namespace ChuSTL {
 					// ֮ԪظԪظ
 					uninitialized_copy(finish - n, finish, finish);
 					finish += n;
-					copy_backward(position, old_finish - n, old_finish);
-					fill(position, position + n, x_copy);
+					ChuSTL::copy_backward(position, old_finish - n, old_finish);
+					ChuSTL::fill(position, position + n, x_copy);
 				}
 				else {
 					// ֮ԪظСڵԪظ
@@ -215,18 +380,17 @@ namespace ChuSTL {
 					finish += n - elems_after;
 					uninitialized_copy(position, old_finish, finish);
 					finish += elems_after;
-					fill(position, old_finish, x_copy);
+					ChuSTL::fill(position, old_finish, x_copy);
 				}
 			}
 			else {
 				// ÿռСԪظöڴ
-				// ³ȣɳɳ+Ԫظ
-				const size_type old_size = size();
-				const size_type len = old_size + max(old_size, n);
+				// ³ȣԾĬΪɳɳ+Ԫظ
+				const size_type len = next_capacity(size() + n);
 				// µvectorռ
 				iterator new_start = data_allocator::allocate(len);
 				iterator new_finish = new_start;
-				__STL_TRY{
+				try {
 					// ȽvectorĲ֮ǰԪظƵ¿ռ
 					new_finish = uninitialized_copy(start, position, new_start);
 					// Ԫ¿ռ䣨ֵΪn
@@ -234,14 +398,12 @@ namespace ChuSTL {
 					// vectorԪظƵ¿ռ
 					new_finish = uninitialized_copy(position, finish, new_finish);
 				}
-		#ifdef __STL_USE_EXCEPTIONS
-					catch (...) {
+				catch (...) {
 					// 쳣ʵ"commit or rollback" semantics.
 					destroy(new_start, new_finish);
 					data_allocator::deallocate(new_start, len);
 					throw;
 				}
-		#endif // __STL_USE_EXCEPTIONS
 				// ͷžvector
 				destroy(start, finish);
 				deallocate();
@@ -254,6 +416,148 @@ namespace ChuSTL {
 		}
 		
 	}
+
+	template<class T, class Alloc, class GrowthPolicy>
+	void vector<T, Alloc, GrowthPolicy>::reallocate(size_type len)
+	{
+		iterator new_start = data_allocator::allocate(len);
+		iterator new_finish = new_start;
+		try {
+			new_finish = uninitialized_copy(start, finish, new_start);
+		}
+		catch (...) {
+			// "commit or rollback" semantics.
+			destroy(new_start, new_finish);
+			data_allocator::deallocate(new_start, len);
+			throw;
+		}
+
+		destroy(start, finish);
+		deallocate();
+
+		start = new_start;
+		finish = new_finish;
+		end_of_storage = new_start + len;
+	}
+
+	template<class T, class Alloc, class GrowthPolicy>
+	void vector<T, Alloc, GrowthPolicy>::assign(size_type n, const T& x)
+	{
+		if (n > capacity()) {
+			// 㣬ֱǡnԪص¿ռ
+			iterator new_start = allocate_and_fill(n, x);
+			destroy(start, finish);
+			deallocate();
+			start = new_start;
+			finish = new_start + n;
+			end_of_storage = finish;
+		}
+		else if (n > size()) {
+			// ԪȫֵڱÿռϹ
+			ChuSTL::fill(begin(), end(), x);
+			finish = uninitialized_fill_n(finish, n - size(), x);
+		}
+		else {
+			erase(ChuSTL::fill_n(begin(), n, x), end());
+		}
+	}
+
+	template<class T, class Alloc, class GrowthPolicy>
+	template<class InputIterator>
+	void vector<T, Alloc, GrowthPolicy>::range_assign(InputIterator first, InputIterator last, input_iterator_tag)
+	{
+		// ȶԪһֵ׷
+		iterator cur = begin();
+		for (; first != last && cur != end(); ++first, ++cur)
+			*cur = *first;
+		if (first == last)
+			erase(cur, end());
+		else
+			for (; first != last; ++first)
+				push_back(*first);
+	}
+
+	template<class T, class Alloc, class GrowthPolicy>
+	template<class ForwardIterator>
+	void vector<T, Alloc, GrowthPolicy>::range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+	{
+		const size_type len = distance(first, last);
+		if (len > capacity()) {
+			// 㣬ǡlenԪص¿ռ
+			iterator new_start = allocate_and_copy(len, first, last);
+			destroy(start, finish);
+			deallocate();
+			start = new_start;
+			finish = new_start + len;
+			end_of_storage = finish;
+		}
+		else if (size() >= len) {
+			iterator new_finish = ChuSTL::copy(first, last, start);
+			destroy(new_finish, finish);
+			finish = new_finish;
+		}
+		else {
+			// ǰsize()ԪظֵڱÿռϹ
+			ForwardIterator mid = first;
+			advance(mid, size());
+			ChuSTL::copy(first, mid, start);
+			finish = uninitialized_copy(mid, last, finish);
+		}
+	}
+
+	template<class T, class Alloc, class GrowthPolicy>
+	template<class ForwardIterator>
+	void vector<T, Alloc, GrowthPolicy>::range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+	{
+		if (first != last) {
+			const size_type n = distance(first, last);
+			if (size_type(end_of_storage - finish) >= n) {
+				// ÿռ㹻insert(position, n, x)ְͬƷʽ
+				const size_type elems_after = finish - position;
+				iterator old_finish = finish;
+				if (elems_after > n) {
+					uninitialized_copy(finish - n, finish, finish);
+					finish += n;
+					ChuSTL::copy_backward(position, old_finish - n, old_finish);
+					ChuSTL::copy(first, last, position);
+				}
+				else {
+					ForwardIterator mid = first;
+					advance(mid, elems_after);
+					uninitialized_copy(mid, last, finish);
+					finish += n - elems_after;
+					uninitialized_copy(position, old_finish, finish);
+					finish += elems_after;
+					ChuSTL::copy(first, mid, position);
+				}
+			}
+			else {
+				// ÿռ䲻㣬һ㹻¿ռ
+				const size_type len = next_capacity(size() + n);
+				iterator new_start = data_allocator::allocate(len);
+				iterator new_finish = new_start;
+				try {
+					new_finish = uninitialized_copy(start, position, new_start);
+					new_finish = uninitialized_copy(first, last, new_finish);
+					new_finish = uninitialized_copy(position, finish, new_finish);
+				}
+				catch (...) {
+					// "commit or rollback" semantics.
+					destroy(new_start, new_finish);
+					data_allocator::deallocate(new_start, len);
+					throw;
+				}
+				destroy(start, finish);
+				deallocate();
+				start = new_start;
+				finish = new_finish;
+				end_of_storage = new_start + len;
+			}
+		}
+	}
 }
 
+// vector<bool>ػ
+#include "BitVector.h"
+
 #endif  // !_CHUSTL_VECTOR_H_
\ No newline at end of file
@@ -0,0 +1,640 @@
+#pragma once
+
+#ifndef _CHUSTL_VIEW_H_
+#define _CHUSTL_VIEW_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>		// for pair, declval
+
+#include "Iterator.h"
+
+namespace ChuSTL {
+
+	/*
+	* ͼ: Եװײ䣬ȡֵʱ㣬ڴ棬ҲԪ
+	* views::filter/transform/take/drop/chunk/zip/enumerateԲǶףĵǰһʱǰһ
+	* ˮʱһѭɣм
+	* ͼĵɵײȡ(filter)ʱȿO(1)֪views::toݴԤÿռ
+	* ͼӵԪأײʹͼڼ䱣Ч
+	*/
+
+	// һԵɵͼviewsĽview<ĳֵ>
+	template<class Iterator>
+	class view {
+	public:
+		typedef Iterator												iterator;
+		typedef typename iterator_traits<Iterator>::value_type			value_type;
+		typedef typename iterator_traits<Iterator>::reference			reference;
+		typedef typename iterator_traits<Iterator>::difference_type	difference_type;
+		typedef size_t													size_type;
+
+	protected:
+		Iterator first;
+		Iterator last;
+
+	public:
+		view() : first(), last() {}
+		view(Iterator i, Iterator j) : first(i), last(j) {}
+
+		iterator begin() const { return first; }
+		iterator end() const { return last; }
+		bool empty() const { return first == last; }
+		// ֻȡṩ
+		size_type size() const { return size_type(last - first); }
+	};
+
+	// ͼĵ
+	template<class Range>
+	struct __range_iterator {
+		typedef decltype(std::declval<Range&>().begin()) type;
+	};
+
+	template<class Iterator>
+	struct __is_random_access_iterator
+		: std::is_convertible<typename iterator_traits<Iterator>::iterator_category, random_access_iterator_tag> {};
+
+	// ͼͣȡ()ȡ˫Ϊǰǰ벻
+	template<class Category>
+	struct __view_category {
+		typedef typename std::conditional<std::is_convertible<Category, random_access_iterator_tag>::value,
+			random_access_iterator_tag,
+			typename std::conditional<std::is_convertible<Category, forward_iterator_tag>::value,
+				forward_iterator_tag, input_iterator_tag>::type>::type type;
+	};
+
+	// ֮нͼ
+	template<class Category1, class Category2>
+	struct __common_view_category {
+		typedef typename __view_category<Category1>::type c1;
+		typedef typename __view_category<Category2>::type c2;
+		typedef typename std::conditional<std::is_convertible<c1, c2>::value, c2, c1>::type type;
+	};
+
+	// ͼеĺ󡣵ɸֵlambdaɸֵ˸ֵʱٸƹ
+	// engaged¼Ƿڣƹ׳쳣ʱΣĬϹĵк
+	template<class Function>
+	struct __view_function {
+		alignas(Function) mutable unsigned char buffer[sizeof(Function)];
+		bool engaged;
+
+		Function& get() const { return *reinterpret_cast<Function*>(buffer); }
+
+		__view_function() : engaged(false) {}
+		__view_function(const Function& fn) : engaged(false) {
+			new (buffer) Function(fn);
+			engaged = true;
+		}
+		__view_function(const __view_function& x) : engaged(false) {
+			if (x.engaged) {
+				new (buffer) Function(x.get());
+				engaged = true;
+			}
+		}
+		~__view_function() {
+			if (engaged)
+				get().~Function();
+		}
+		__view_function& operator=(const __view_function& x) {
+			if (this != &x) {
+				if (engaged) {
+					engaged = false;
+					get().~Function();
+				}
+				if (x.engaged) {
+					new (buffer) Function(x.get());
+					engaged = true;
+				}
+			}
+			return *this;
+		}
+	};
+
+	// filterĵpredԪءҪײյ㣬Ϊǰ
+	template<class Iterator, class Predicate>
+	class __filter_iterator {
+	public:
+		typedef typename __common_view_category<typename iterator_traits<Iterator>::iterator_category,
+			forward_iterator_tag>::type									iterator_category;
+		typedef typename iterator_traits<Iterator>::value_type			value_type;
+		typedef typename iterator_traits<Iterator>::difference_type	difference_type;
+		typedef typename iterator_traits<Iterator>::pointer			pointer;
+		typedef typename iterator_traits<Iterator>::reference			reference;
+		typedef __filter_iterator										self;
+
+	protected:
+		Iterator cur;
+		Iterator last;
+		__view_function<Predicate> pred;
+
+		void satisfy() {
+			while (cur != last && !pred.get()(*cur))
+				++cur;
+		}
+
+	public:
+		__filter_iterator() : cur(), last(), pred() {}
+		__filter_iterator(Iterator i, Iterator j, const Predicate& p) : cur(i), last(j), pred(p) { satisfy(); }
+
+		Iterator base() const { return cur; }
+		reference operator*() const { return *cur; }
+
+		self& operator++() {
+			++cur;
+			satisfy();
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const self& x) const { return cur == x.cur; }
+		bool operator!=(const self& x) const { return cur != x.cur; }
+	};
+
+	// transformĵȡֵʱf(*cur)Ҫյ㣬ֵײĵͣΪȡ
+	template<class Iterator, class Function>
+	class __transform_iterator {
+	public:
+		typedef typename iterator_traits<Iterator>::iterator_category	base_category;
+		typedef typename std::conditional<std::is_convertible<base_category, contiguous_iterator_tag>::value,
+			random_access_iterator_tag, base_category>::type				iterator_category;
+		typedef decltype(std::declval<Function&>()(*std::declval<Iterator&>()))	reference;
+		typedef typename std::remove_cv<typename std::remove_reference<reference>::type>::type	value_type;
+		typedef typename iterator_traits<Iterator>::difference_type	difference_type;
+		typedef void													pointer;
+		typedef __transform_iterator									self;
+
+	protected:
+		Iterator cur;
+		__view_function<Function> fn;
+
+	public:
+		__transform_iterator() : cur(), fn() {}
+		__transform_iterator(Iterator i, const Function& f) : cur(i), fn(f) {}
+
+		Iterator base() const { return cur; }
+		reference operator*() const { return fn.get()(*cur); }
+		reference operator[](difference_type n) const { return fn.get()(cur[n]); }
+
+		self& operator++() { ++cur; return *this; }
+		self operator++(int) { self tmp = *this; ++cur; return tmp; }
+		self& operator--() { --cur; return *this; }
+		self operator--(int) { self tmp = *this; --cur; return tmp; }
+		self& operator+=(difference_type n) { cur += n; return *this; }
+		self& operator-=(difference_type n) { cur -= n; return *this; }
+		self operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+		self operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+		difference_type operator-(const self& x) const { return cur - x.cur; }
+
+		bool operator==(const self& x) const { return cur == x.cur; }
+		bool operator!=(const self& x) const { return cur != x.cur; }
+		bool operator<(const self& x) const { return cur < x.cur; }
+	};
+
+	// takeĵȡʱԼضϡȡn򵽴ײյʱյ
+	// ȡƽײײΪfilterͼʱΪ˶ɨ赽һƥ
+	template<class Iterator>
+	class __counted_iterator {
+	public:
+		typedef typename __common_view_category<typename iterator_traits<Iterator>::iterator_category,
+			forward_iterator_tag>::type									iterator_category;
+		typedef typename iterator_traits<Iterator>::value_type			value_type;
+		typedef typename iterator_traits<Iterator>::difference_type	difference_type;
+		typedef typename iterator_traits<Iterator>::pointer			pointer;
+		typedef typename iterator_traits<Iterator>::reference			reference;
+		typedef __counted_iterator										self;
+
+	protected:
+		Iterator cur;
+		difference_type n;		// ȡĸ
+
+	public:
+		__counted_iterator() : cur(), n(0) {}
+		__counted_iterator(Iterator i, difference_type count) : cur(i), n(count) {}
+
+		Iterator base() const { return cur; }
+		reference operator*() const { return *cur; }
+
+		self& operator++() {
+			if (--n != 0)
+				++cur;
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const self& x) const { return n == x.n || cur == x.cur; }
+		bool operator!=(const self& x) const { return !(*this == x); }
+	};
+
+	// chunkĵ(ǰ)ÿȡnԪعɵͼ
+	template<class Iterator>
+	class __chunk_iterator {
+	public:
+		typedef forward_iterator_tag									iterator_category;
+		typedef view<Iterator>											value_type;
+		typedef view<Iterator>											reference;
+		typedef typename iterator_traits<Iterator>::difference_type	difference_type;
+		typedef void													pointer;
+		typedef __chunk_iterator										self;
+
+	protected:
+		Iterator cur;
+		Iterator next;		// ǰյ
+		Iterator last;
+		difference_type n;
+
+		Iterator step(Iterator i) const {
+			for (difference_type k = n; k > 0 && i != last; --k)
+				++i;
+			return i;
+		}
+
+	public:
+		__chunk_iterator() : cur(), next(), last(), n(0) {}
+		__chunk_iterator(Iterator i, Iterator j, difference_type count) : cur(i), next(i), last(j), n(count) {
+			next = step(cur);
+		}
+
+		reference operator*() const { return reference(cur, next); }
+
+		self& operator++() {
+			cur = next;
+			next = step(cur);
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const self& x) const { return cur == x.cur; }
+		bool operator!=(const self& x) const { return cur != x.cur; }
+	};
+
+	// chunkĵ(ȡ)ԿŶλindexΪ[first + index * n, first + min((index + 1) * n, len))
+	template<class Iterator>
+	class __chunk_ra_iterator {
+	public:
+		typedef random_access_iterator_tag								iterator_category;
+		typedef view<Iterator>											value_type;
+		typedef view<Iterator>											reference;
+		typedef typename iterator_traits<Iterator>::difference_type	difference_type;
+		typedef void													pointer;
+		typedef __chunk_ra_iterator										self;
+
+	protected:
+		Iterator first;
+		difference_type len;
+		difference_type n;
+		difference_type index;
+
+	public:
+		__chunk_ra_iterator() : first(), len(0), n(0), index(0) {}
+		__chunk_ra_iterator(Iterator i, difference_type length, difference_type count, difference_type k)
+			: first(i), len(length), n(count), index(k) {}
+
+		reference operator*() const { return (*this)[0]; }
+		reference operator[](difference_type k) const {
+			difference_type i = (index + k) * n;
+			difference_type j = len - i > n ? i + n : len;
+			return reference(first + i, first + j);
+		}
+
+		self& operator++() { ++index; return *this; }
+		self operator++(int) { self tmp = *this; ++index; return tmp; }
+		self& operator--() { --index; return *this; }
+		self operator--(int) { self tmp = *this; --index; return tmp; }
+		self& operator+=(difference_type k) { index += k; return *this; }
+		self& operator-=(difference_type k) { index -= k; return *this; }
+		self operator+(difference_type k) const { self tmp = *this; return tmp += k; }
+		self operator-(difference_type k) const { self tmp = *this; return tmp -= k; }
+		difference_type operator-(const self& x) const { return index - x.index; }
+
+		bool operator==(const self& x) const { return index == x.index; }
+		bool operator!=(const self& x) const { return index != x.index; }
+		bool operator<(const self& x) const { return index < x.index; }
+	};
+
+	// zipĵȡֵʱײԪùɵpair϶̵һյ㼴
+	template<class Iterator1, class Iterator2>
+	class __zip_iterator {
+	public:
+		typedef typename __common_view_category<typename iterator_traits<Iterator1>::iterator_category,
+			typename iterator_traits<Iterator2>::iterator_category>::type	iterator_category;
+		typedef std::pair<typename iterator_traits<Iterator1>::value_type,
+			typename iterator_traits<Iterator2>::value_type>			value_type;
+		typedef std::pair<typename iterator_traits<Iterator1>::reference,
+			typename iterator_traits<Iterator2>::reference>				reference;
+		typedef typename iterator_traits<Iterator1>::difference_type	difference_type;
+		typedef void													pointer;
+		typedef __zip_iterator											self;
+
+	protected:
+		Iterator1 i1;
+		Iterator2 i2;
+
+	public:
+		__zip_iterator() : i1(), i2() {}
+		__zip_iterator(Iterator1 x, Iterator2 y) : i1(x), i2(y) {}
+
+		reference operator*() const { return reference(*i1, *i2); }
+		reference operator[](difference_type n) const { return reference(i1[n], i2[n]); }
+
+		self& operator++() { ++i1; ++i2; return *this; }
+		self operator++(int) { self tmp = *this; ++*this; return tmp; }
+		self& operator--() { --i1; --i2; return *this; }
+		self operator--(int) { self tmp = *this; --*this; return tmp; }
+		self& operator+=(difference_type n) { i1 += n; i2 += n; return *this; }
+		self& operator-=(difference_type n) { i1 -= n; i2 -= n; return *this; }
+		self operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+		self operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+		difference_type operator-(const self& x) const { return i1 - x.i1; }
+
+		bool operator==(const self& x) const { return i1 == x.i1 || i2 == x.i2; }
+		bool operator!=(const self& x) const { return !(*this == x); }
+		bool operator<(const self& x) const { return i1 < x.i1; }
+	};
+
+	// enumerateĵȡֵʱ(±, Ԫ)ɵpair
+	template<class Iterator>
+	class __enumerate_iterator {
+	public:
+		typedef typename __view_category<typename iterator_traits<Iterator>::iterator_category>::type	iterator_category;
+		typedef typename iterator_traits<Iterator>::difference_type	difference_type;
+		typedef std::pair<difference_type, typename iterator_traits<Iterator>::value_type>	value_type;
+		typedef std::pair<difference_type, typename iterator_traits<Iterator>::reference>	reference;
+		typedef void													pointer;
+		typedef __enumerate_iterator									self;
+
+	protected:
+		Iterator cur;
+		difference_type index;
+
+	public:
+		__enumerate_iterator() : cur(), index(0) {}
+		__enumerate_iterator(Iterator i, difference_type k) : cur(i), index(k) {}
+
+		Iterator base() const { return cur; }
+		reference operator*() const { return reference(index, *cur); }
+		reference operator[](difference_type n) const { return reference(index + n, cur[n]); }
+
+		self& operator++() { ++cur; ++index; return *this; }
+		self operator++(int) { self tmp = *this; ++*this; return tmp; }
+		self& operator--() { --cur; --index; return *this; }
+		self operator--(int) { self tmp = *this; --*this; return tmp; }
+		self& operator+=(difference_type n) { cur += n; index += n; return *this; }
+		self& operator-=(difference_type n) { cur -= n; index -= n; return *this; }
+		self operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+		self operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+		difference_type operator-(const self& x) const { return cur - x.cur; }
+
+		bool operator==(const self& x) const { return cur == x.cur; }
+		bool operator!=(const self& x) const { return cur != x.cur; }
+		bool operator<(const self& x) const { return cur < x.cur; }
+	};
+
+	// ¸ݵײǷȡѡͼĹ췽ʽ
+
+	// ȡʱֱӽȡ[first, first + n)ǵײĵ
+	template<class Iterator, bool = __is_random_access_iterator<Iterator>::value>
+	struct __take_view {
+		typedef __counted_iterator<Iterator> iterator;
+		typedef view<iterator> type;
+
+		static type make(Iterator first, Iterator last, size_t n) {
+			return type(iterator(first, n), iterator(last, 0));
+		}
+	};
+
+	template<class Iterator>
+	struct __take_view<Iterator, true> {
+		typedef view<Iterator> type;
+
+		static type make(Iterator first, Iterator last, size_t n) {
+			return type(first, size_t(last - first) > n ? first + n : last);
+		}
+	};
+
+	template<class InputIterator>
+	inline InputIterator __drop(InputIterator first, InputIterator last, size_t n, input_iterator_tag) {
+		for (; n > 0 && first != last; --n)
+			++first;
+		return first;
+	}
+
+	template<class RandomAccessIterator>
+	inline RandomAccessIterator __drop(RandomAccessIterator first, RandomAccessIterator last, size_t n,
+		random_access_iterator_tag) {
+		return size_t(last - first) > n ? first + n : last;
+	}
+
+	template<class Iterator, bool = __is_random_access_iterator<Iterator>::value>
+	struct __chunk_view {
+		typedef __chunk_iterator<Iterator> iterator;
+		typedef view<iterator> type;
+
+		static type make(Iterator first, Iterator last, size_t n) {
+			return type(iterator(first, last, n), iterator(last, last, n));
+		}
+	};
+
+	template<class Iterator>
+	struct __chunk_view<Iterator, true> {
+		typedef __chunk_ra_iterator<Iterator> iterator;
+		typedef view<iterator> type;
+
+		static type make(Iterator first, Iterator last, size_t n) {
+			typedef typename iterator_traits<Iterator>::difference_type difference_type;
+			difference_type len = last - first;
+			difference_type count = difference_type(n);
+			return type(iterator(first, len, count, 0), iterator(first, len, count, (len + count - 1) / count));
+		}
+	};
+
+	// ˶ȡʱյ뵽϶̵һʹoperator-׼ȷ
+	template<class Iterator1, class Iterator2, bool = __is_random_access_iterator<Iterator1>::value
+		&& __is_random_access_iterator<Iterator2>::value>
+	struct __zip_view {
+		typedef __zip_iterator<Iterator1, Iterator2> iterator;
+		typedef view<iterator> type;
+
+		static type make(Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2) {
+			return type(iterator(first1, first2), iterator(last1, last2));
+		}
+	};
+
+	template<class Iterator1, class Iterator2>
+	struct __zip_view<Iterator1, Iterator2, true> {
+		typedef __zip_iterator<Iterator1, Iterator2> iterator;
+		typedef view<iterator> type;
+
+		static type make(Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2) {
+			typedef typename iterator_traits<Iterator1>::difference_type difference_type;
+			difference_type n = last1 - first1;
+			if (difference_type(last2 - first2) < n)
+				n = difference_type(last2 - first2);
+			return type(iterator(first1, first2), iterator(first1 + n, first2 + n));
+		}
+	};
+
+	template<class InputIterator>
+	inline typename iterator_traits<InputIterator>::difference_type
+		__enumerate_end_index(InputIterator, InputIterator, input_iterator_tag) {
+		return 0;	// ȡʱյֻȽϵײ
+	}
+
+	template<class RandomAccessIterator>
+	inline typename iterator_traits<RandomAccessIterator>::difference_type
+		__enumerate_end_index(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag) {
+		return last - first;
+	}
+
+	// Ƿṩreserve
+	template<class Container>
+	struct __has_reserve {
+		template<class C>
+		static char test(int, decltype(std::declval<C&>().reserve(size_t()))* = 0);
+		template<class C>
+		static long test(...);
+
+		typedef std::integral_constant<bool, sizeof(test<Container>(0)) == 1> type;
+	};
+
+	template<class Container>
+	inline void __view_reserve(Container& c, size_t n, std::true_type) {
+		c.reserve(n);
+	}
+
+	template<class Container>
+	inline void __view_reserve(Container&, size_t, std::false_type) {}
+
+	template<class Container, class InputIterator>
+	inline void __view_append(Container& c, InputIterator first, InputIterator last, input_iterator_tag) {
+		for (; first != last; ++first)
+			c.push_back(*first);
+	}
+
+	// ֪һúÿռ䣬
+	template<class Container, class RandomAccessIterator>
+	inline void __view_append(Container& c, RandomAccessIterator first, RandomAccessIterator last,
+		random_access_iterator_tag) {
+		__view_reserve(c, size_t(last - first), typename __has_reserve<Container>::type());
+		for (; first != last; ++first)
+			c.push_back(*first);
+	}
+
+	namespace views {
+
+		// ͼȫԪ
+		template<class Range>
+		inline view<typename __range_iterator<Range>::type> all(Range&& r) {
+			return view<typename __range_iterator<Range>::type>(r.begin(), r.end());
+		}
+
+		// predԪ
+		template<class Range, class Predicate>
+		inline view<__filter_iterator<typename __range_iterator<Range>::type, Predicate> >
+			filter(Range&& r, Predicate pred) {
+			typedef __filter_iterator<typename __range_iterator<Range>::type, Predicate> iterator;
+			return view<iterator>(iterator(r.begin(), r.end(), pred), iterator(r.end(), r.end(), pred));
+		}
+
+		// ÿԪصfĽ
+		template<class Range, class Function>
+		inline view<__transform_iterator<typename __range_iterator<Range>::type, Function> >
+			transform(Range&& r, Function f) {
+			typedef __transform_iterator<typename __range_iterator<Range>::type, Function> iterator;
+			return view<iterator>(iterator(r.begin(), f), iterator(r.end(), f));
+		}
+
+		// ǰnԪأnʱΪȫ
+		template<class Range>
+		inline typename __take_view<typename __range_iterator<Range>::type>::type take(Range&& r, size_t n) {
+			return __take_view<typename __range_iterator<Range>::type>::make(r.begin(), r.end(), n);
+		}
+
+		// ǰnԪ֮Ĳ֣ڽͼʱǰȡʱΪO(n)
+		template<class Range>
+		inline view<typename __range_iterator<Range>::type> drop(Range&& r, size_t n) {
+			typedef typename __range_iterator<Range>::type iterator;
+			iterator last = r.end();
+			return view<iterator>(__drop(r.begin(), last, n, iterator_category(last)), last);
+		}
+
+		// ÿnԪһͼһܲnn0ײΪǰ
+		template<class Range>
+		inline typename __chunk_view<typename __range_iterator<Range>::type>::type chunk(Range&& r, size_t n) {
+			return __chunk_view<typename __range_iterator<Range>::type>::make(r.begin(), r.end(), n);
+		}
+
+		// ĶӦԪأΪ϶̵һ
+		template<class Range1, class Range2>
+		inline typename __zip_view<typename __range_iterator<Range1>::type, typename __range_iterator<Range2>::type>::type
+			zip(Range1&& r1, Range2&& r2) {
+			return __zip_view<typename __range_iterator<Range1>::type, typename __range_iterator<Range2>::type>::make(
+				r1.begin(), r1.end(), r2.begin(), r2.end());
+		}
+
+		// ±Ԫأ±0ʼ
+		template<class Range>
+		inline view<__enumerate_iterator<typename __range_iterator<Range>::type> > enumerate(Range&& r) {
+			typedef typename __range_iterator<Range>::type base_iterator;
+			typedef __enumerate_iterator<base_iterator> iterator;
+			base_iterator first = r.begin();
+			base_iterator last = r.end();
+			return view<iterator>(iterator(first, 0), iterator(last, __enumerate_end_index(first, last, iterator_category(first))));
+		}
+
+		// ͼԪؽ֪ṩreserveʱֻһ
+		template<class Container, class Range>
+		inline Container to(Range&& r) {
+			typedef typename __range_iterator<Range>::type iterator;
+			Container c;
+			iterator first = r.begin();
+			__view_append(c, first, iterator(r.end()), iterator_category(first));
+			return c;
+		}
+
+		// init = op(init, x)ۻÿԪ
+		template<class Range, class T, class BinaryOperation>
+		inline T reduce(Range&& r, T init, BinaryOperation op) {
+			typedef typename __range_iterator<Range>::type iterator;
+			iterator last = r.end();
+			for (iterator first = r.begin(); first != last; ++first)
+				init = op(init, *first);
+			return init;
+		}
+
+		template<class Range, class T>
+		inline T reduce(Range&& r, T init) {
+			typedef typename __range_iterator<Range>::type iterator;
+			iterator last = r.end();
+			for (iterator first = r.begin(); first != last; ++first)
+				init = init + *first;
+			return init;
+		}
+
+		// ÿԪصff
+		template<class Range, class Function>
+		inline Function for_each(Range&& r, Function f) {
+			typedef typename __range_iterator<Range>::type iterator;
+			iterator last = r.end();
+			for (iterator first = r.begin(); first != last; ++first)
+				f(*first);
+			return f;
+		}
+
+	}
+
+}
+
+#endif // !_CHUSTL_VIEW_H_
\ No newline at end of file
@@ -0,0 +1,182 @@
+#pragma once
+
+#ifndef _CHUSTL_WORKSTEALINGDEQUE_H_
+#define _CHUSTL_WORKSTEALINGDEQUE_H_
+
+#include <atomic>
+
+#include "Allocator.h"
+#include "Alloc.h"
+#include "SpscQueue.h"	// for __cache_line_size
+
+namespace ChuSTL {
+
+	// ws_dequeĻ״飬±Ϊ߼λãȡģֻ
+	// Կܱsteal̶߳ȡ˴prevϣֱws_dequeͷ
+	template<class T>
+	struct __ws_array {
+		ptrdiff_t cap;
+		std::atomic<T>* slots;
+		__ws_array* prev;
+
+		T get(ptrdiff_t i) const { return slots[i & (cap - 1)].load(std::memory_order_relaxed); }
+		void put(ptrdiff_t i, T x) { slots[i & (cap - 1)].store(x, std::memory_order_relaxed); }
+	};
+
+	/*
+	* ws_deque: Chase-Levȡ˫˶
+	* ӵbottompush/popͬһջ߳topCAS stealȡԪ
+	* ֻʣһԪʱӵ߲Ҫȡ߾popԭӶд
+	* ԪƽƣͨΪָָ룻ʱӵ߽ӱ
+	* steal߳̾ʧʱҲfalseʱδΪ
+	*/
+	template<class T, class Alloc> // class Alloc = alloc
+	class ws_deque {
+	public:
+		typedef T						value_type;
+		typedef size_t					size_type;
+
+	protected:
+		typedef __ws_array<T> array;
+		typedef simple_alloc<array, Alloc> array_allocator;
+		typedef simple_alloc<std::atomic<T>, Alloc> slot_allocator;
+
+		// ȡ֮侺
+		alignas(__cache_line_size) std::atomic<ptrdiff_t> top;
+		// ֻӵд
+		alignas(__cache_line_size) std::atomic<ptrdiff_t> bottom;
+		std::atomic<array*> arr;
+
+		static array* allocate_array(ptrdiff_t cap, array* prev);
+		// [t, b)Ƶӱ飬ʱͷ
+		array* grow(array* a, ptrdiff_t b, ptrdiff_t t);
+
+	private:
+		ws_deque(const ws_deque&);
+		ws_deque& operator=(const ws_deque&);
+
+	public:
+		// ʼΪСn2
+		explicit ws_deque(size_type n = 64);
+		~ws_deque();
+
+		// ڲʱֻǽֵ
+		size_type size() const {
+			ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+			ptrdiff_t t = top.load(std::memory_order_relaxed);
+			return b > t ? size_type(b - t) : 0;
+		}
+		bool empty() const { return size() == 0; }
+		size_type capacity() const { return size_type(arr.load(std::memory_order_relaxed)->cap); }
+
+		// ֻӵߵ
+		void push(T x);
+		bool pop(T& result);
+		// κ̶߳ɵ
+		bool steal(T& result);
+	};
+
+	template<class T, class Alloc>
+	typename ws_deque<T, Alloc>::array* ws_deque<T, Alloc>::allocate_array(ptrdiff_t cap, array* prev)
+	{
+		array* a = array_allocator::allocate();
+		try {
+			a->slots = slot_allocator::allocate(size_type(cap));
+		}
+		catch (...) {
+			array_allocator::deallocate(a);
+			throw;
+		}
+		for (ptrdiff_t i = 0; i != cap; ++i)
+			new (&a->slots[i]) std::atomic<T>(T());
+		a->cap = cap;
+		a->prev = prev;
+		return a;
+	}
+
+	template<class T, class Alloc>
+	ws_deque<T, Alloc>::ws_deque(size_type n) : top(0), bottom(0), arr(0)
+	{
+		ptrdiff_t cap = 1;
+		while (size_type(cap) < n)
+			cap <<= 1;
+		arr.store(allocate_array(cap, 0), std::memory_order_relaxed);
+	}
+
+	template<class T, class Alloc>
+	ws_deque<T, Alloc>::~ws_deque()
+	{
+		array* a = arr.load(std::memory_order_relaxed);
+		while (a) {
+			array* prev = a->prev;
+			slot_allocator::deallocate(a->slots, size_type(a->cap));
+			array_allocator::deallocate(a);
+			a = prev;
+		}
+	}
+
+	template<class T, class Alloc>
+	typename ws_deque<T, Alloc>::array* ws_deque<T, Alloc>::grow(array* a, ptrdiff_t b, ptrdiff_t t)
+	{
+		array* new_arr = allocate_array(a->cap * 2, a);
+		for (ptrdiff_t i = t; i != b; ++i)
+			new_arr->put(i, a->get(i));
+		arr.store(new_arr, std::memory_order_release);
+		return new_arr;
+	}
+
+	template<class T, class Alloc>
+	void ws_deque<T, Alloc>::push(T x)
+	{
+		ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		ptrdiff_t t = top.load(std::memory_order_acquire);
+		array* a = arr.load(std::memory_order_relaxed);
+		if (b - t > a->cap - 1)
+			a = grow(a, b, t);
+		a->put(b, x);
+		bottom.store(b + 1, std::memory_order_release);
+	}
+
+	template<class T, class Alloc>
+	bool ws_deque<T, Alloc>::pop(T& result)
+	{
+		// óbottomԪأٿȡǷҲߵ
+		ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+		array* a = arr.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		ptrdiff_t t = top.load(std::memory_order_relaxed);
+		if (t > b) {
+			// ѿ
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		result = a->get(b);
+		if (t == b) {
+			// һԪأȡCAS
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	template<class T, class Alloc>
+	bool ws_deque<T, Alloc>::steal(T& result)
+	{
+		ptrdiff_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		ptrdiff_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b)
+			return false;
+		array* a = arr.load(std::memory_order_acquire);
+		T x = a->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false;
+		result = x;
+		return true;
+	}
+
+}
+
+#endif // !_CHUSTL_WORKSTEALINGDEQUE_H_
\ No newline at end of file
@@ -0,0 +1,139 @@
+// concurrent_map/concurrent_setĲԣg++ -std=c++11 -pthread -Iinclude test/ConcurrentSkipListTest.cpp
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentSkipList.h"
+
+using namespace ChuSTL;
+
+// ͳô黹ʱȰͿͷŵĽڵЧֵ
+struct counting_alloc {
+	static std::atomic<long> outstanding;
+	static void* allocate(size_t n) { ++outstanding; return malloc(n); }
+	static void deallocate(void* p, size_t n) { --outstanding; memset(p, 0xdd, n); free(p); }
+};
+std::atomic<long> counting_alloc::outstanding(0);
+
+typedef epoch_reclaimer<counting_alloc> epoch;
+typedef concurrent_set<int, counting_alloc> int_set;
+typedef concurrent_map<int, int, counting_alloc> int_map;
+
+// գȷԪǡΪ[0, n)
+static void check_sequence(const int_set& s, int n) {
+	int_set::snapshot snap = s.get_snapshot();
+	int expected = 0;
+	for (int_set::const_iterator i = snap.begin(); i != snap.end(); ++i)
+		assert(*i == expected++);
+	assert(expected == n);
+}
+
+// 롢ɾҵĻ
+static void test_basic() {
+	int_map m;
+	for (int i = 0; i < 1000; ++i)
+		assert(m.insert(i, i * 2));
+	assert(!m.insert(10, 0));
+	assert(m.size() == 1000);
+	int x = 0;
+	assert(m.find(10, x) && x == 20);
+	for (int i = 0; i < 1000; i += 2)
+		assert(m.erase(i));
+	assert(!m.erase(0));
+	assert(m.size() == 500);
+	assert(!m.contains(0) && m.contains(1));
+	assert(m.insert(0, 7) && m.find(0, x) && x == 7);
+}
+
+// տǴʱݣ֮޸Ķɼ
+static void test_snapshot() {
+	int_set s;
+	for (int i = 0; i < 100; ++i)
+		s.insert(i);
+	{
+		int_set::snapshot snap = s.get_snapshot();
+		for (int i = 0; i < 100; i += 2)
+			s.erase(i);
+		s.insert(1000);
+		int n = 0;
+		for (int_set::const_iterator i = snap.begin(); i != snap.end(); ++i)
+			assert(*i == n++);
+		assert(n == 100);
+		assert(snap.find(1000) == snap.end());
+		assert(*snap.lower_bound(50) == 50 && *snap.upper_bound(50) == 51);
+	}
+	int_set::snapshot now = s.get_snapshot();
+	assert(*now.begin() == 1 && now.find(50) == now.end() && now.find(1000) != now.end());
+}
+
+// Ƴժڼٴβͬһ½ڵھɽڵ֮󣬿ܱ
+// չرպɽڵÿһժ֮ıߵͷŵĽڵ
+static void test_reinsert_under_snapshot() {
+	const int n = 64;
+	for (int round = 0; round < 50; ++round) {
+		int_set s;
+		for (int i = 0; i < n; ++i)
+			s.insert(i);
+		for (int k = 0; k < n; ++k) {
+			{
+				int_set::snapshot snap = s.get_snapshot();
+				assert(s.erase(k));
+				assert(s.insert(k));
+				assert(snap.find(k) != snap.end());
+			}
+			epoch::flush();
+			check_sequence(s, n);
+		}
+	}
+	epoch::flush();
+	assert(epoch::stats().pending == 0);
+}
+
+// ߳ڻصļϲɾͬʱжߴ򿪿ձ
+static void test_concurrent() {
+	const int writers = 4, keys = 2000;
+	int_set s;
+	std::atomic<bool> done(false);
+	std::thread reader([&] {
+		while (!done) {
+			int_set::snapshot snap = s.get_snapshot();
+			int last = -1;
+			for (int_set::const_iterator i = snap.begin(); i != snap.end(); ++i) {
+				assert(*i > last && *i < writers * keys);
+				last = *i;
+			}
+		}
+	});
+	std::vector<std::thread> threads;
+	for (int t = 0; t < writers; ++t)
+		threads.push_back(std::thread([&s, t] {
+			for (int round = 0; round < 5; ++round) {
+				for (int i = t; i < writers * keys; i += writers)
+					assert(s.insert(i));
+				for (int i = t; i < writers * keys; i += writers)
+					assert(s.erase(i));
+			}
+			for (int i = t; i < writers * keys; i += writers)
+				assert(s.insert(i));
+		}));
+	for (size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+	done = true;
+	reader.join();
+	assert(s.size() == size_t(writers * keys));
+	check_sequence(s, writers * keys);
+}
+
+int main() {
+	test_basic();
+	test_snapshot();
+	test_reinsert_under_snapshot();
+	test_concurrent();
+	epoch::flush();
+	epoch::unregister_thread();
+	printf("concurrent skip list: all tests passed, %ld blocks outstanding (thread records)\n", (long)counting_alloc::outstanding);
+	return 0;
+}
\ No newline at end of file
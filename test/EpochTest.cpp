@@ -0,0 +1,169 @@
+// epoch_reclaimerĲԣg++ -std=c++11 -pthread -Iinclude test/EpochTest.cpp
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "Epoch.h"
+
+using namespace ChuSTL;
+
+// ͳôԱȷжѹ黹
+struct counting_alloc {
+	static std::atomic<long> outstanding;
+	static void* allocate(size_t n) { ++outstanding; return malloc(n); }
+	static void deallocate(void* p, size_t) { --outstanding; free(p); }
+};
+std::atomic<long> counting_alloc::outstanding(0);
+
+typedef epoch_reclaimer<counting_alloc> epoch;
+
+struct object : epoch_retired {
+	static std::atomic<int> live;
+	enum { alive = 0x5a5a5a5a };
+	int magic;
+	object() : magic(alive) { ++live; }
+	~object() { magic = 0; --live; }
+};
+std::atomic<int> object::live(0);
+
+static object* make_object() {
+	object* p = simple_alloc<object, counting_alloc>::allocate();
+	new (p) object();
+	return p;
+}
+
+static void retire_some(int n) {
+	for (int i = 0; i < n; ++i) {
+		epoch::guard g;
+		epoch::retire_object(make_object());
+	}
+}
+
+// ߳ժflushȫͷ
+static void test_retire_flush() {
+	retire_some(1000);
+	epoch_stats s = epoch::stats();
+	assert(s.threads == 1);
+	assert(s.pending > 0 && s.pending <= 1000);
+	epoch::flush();
+	s = epoch::stats();
+	assert(s.pending == 0);
+	assert(object::live == 0);
+}
+
+// pendingʵδͷŵĶһ
+static void test_pending() {
+	epoch::flush();
+	{
+		// λٽʱepoch޷Խ̣߳ժĶ󶼲ͷ
+		epoch::guard g;
+		for (int i = 0; i < 10; ++i)
+			epoch::retire_object(make_object());
+		assert(epoch::stats().pending == 10);
+		assert(object::live == 10);
+	}
+	epoch::flush();
+	assert(epoch::stats().pending == 0);
+	assert(object::live == 0);
+}
+
+// ߳̽ʱµĶ߳̽ӹͷţ¼̸߳
+static void test_adopt() {
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.push_back(std::thread([] { retire_some(500); }));
+	for (size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+	epoch_stats s = epoch::stats();
+	assert(s.threads == 1);
+	size_t records = s.records;
+	epoch::flush();
+	assert(epoch::stats().pending == 0);
+	assert(object::live == 0);
+
+	std::thread([] {
+		epoch::register_thread();
+		assert(epoch::stats().threads == 2);
+		retire_some(10);
+		epoch::unregister_thread();
+		assert(epoch::stats().threads == 1);
+	}).join();
+	assert(epoch::stats().records == records);
+	epoch::flush();
+	assert(epoch::stats().pending == 0);
+	assert(object::live == 0);
+}
+
+// ͣٽֹ߳ͷţ뿪ͷ
+static void test_stalled_reader() {
+	std::atomic<int> phase(0);
+	std::thread reader([&] {
+		{
+			epoch::guard g;
+			phase = 1;
+			while (phase != 2)
+				std::this_thread::yield();
+		}
+		phase = 3;
+	});
+	while (phase != 1)
+		std::this_thread::yield();
+	retire_some(500);
+	epoch::flush();
+	assert(epoch::stats().pending > 0);
+	phase = 2;
+	reader.join();
+	epoch::flush();
+	assert(epoch::stats().pending == 0);
+	assert(object::live == 0);
+}
+
+// ̲߳滻ժ󣬶ٽڶĶʼδͷ
+static void test_stress() {
+	const int writers = 4, readers = 4, rounds = 20000;
+	std::atomic<object*> slot(make_object());
+	std::atomic<bool> done(false);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < readers; ++t)
+		threads.push_back(std::thread([&] {
+			while (!done) {
+				epoch::guard g;
+				object* p = slot.load(std::memory_order_acquire);
+				assert(p->magic == object::alive);
+			}
+		}));
+	for (int t = 0; t < writers; ++t)
+		threads.push_back(std::thread([&] {
+			for (int i = 0; i < rounds; ++i) {
+				epoch::guard g;
+				object* old = slot.exchange(make_object(), std::memory_order_acq_rel);
+				epoch::retire_object(old);
+			}
+		}));
+	for (size_t t = readers; t < threads.size(); ++t)
+		threads[t].join();
+	done = true;
+	for (int t = 0; t < readers; ++t)
+		threads[t].join();
+
+	epoch::flush();
+	assert(epoch::stats().pending == 0);
+	assert(object::live == 1);
+	object* p = slot.load();
+	destroy(p);
+	simple_alloc<object, counting_alloc>::deallocate(p);
+}
+
+int main() {
+	test_retire_flush();
+	test_pending();
+	test_adopt();
+	test_stalled_reader();
+	test_stress();
+	epoch::unregister_thread();
+	assert(object::live == 0);
+	printf("epoch_reclaimer: all tests passed, %ld blocks outstanding (thread records)\n", (long)counting_alloc::outstanding);
+	return 0;
+}
\ No newline at end of file